@@ -95,6 +95,44 @@
     #define ESP_NN                                  1
 #endif
 
+// Keep compiled (EON) graphs initialized between inferences, so the arena
+// allocation and kernel Init/Prepare run only once; run_classifier_deinit() releases them
+#ifndef EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+#define EI_CLASSIFIER_TFLITE_EON_PERSISTENT         0
+#endif // EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+
+// Take the scratch memory of process_impulse (feature matrices and DSP temporaries) from
+// a per-handle bump arena that is reset every run. A size of 0 sizes it from the impulse.
+#ifndef EI_CLASSIFIER_IMPULSE_ARENA
+#define EI_CLASSIFIER_IMPULSE_ARENA                 0
+#endif // EI_CLASSIFIER_IMPULSE_ARENA
+
+#ifndef EI_CLASSIFIER_IMPULSE_ARENA_SIZE
+#define EI_CLASSIFIER_IMPULSE_ARENA_SIZE            0
+#endif // EI_CLASSIFIER_IMPULSE_ARENA_SIZE
+
+// Run spectral analysis (FFT, no filter) in fixed point and write the features quantized
+// straight into the int8 input tensor of an EON compiled model, see feature_q15.hpp
+#ifndef EI_CLASSIFIER_SPECTRAL_QUANTIZED
+#define EI_CLASSIFIER_SPECTRAL_QUANTIZED            0
+#endif // EI_CLASSIFIER_SPECTRAL_QUANTIZED
+
+// Use the specialized invoke of compiled (EON) graphs that are a chain of int8 FULLY_CONNECTED
+// layers: kernels with compile-time shapes and requantization, see tflite_eon_dense.h
+#ifndef EI_CLASSIFIER_TFLITE_EON_DENSE
+#define EI_CLASSIFIER_TFLITE_EON_DENSE              0
+#endif // EI_CLASSIFIER_TFLITE_EON_DENSE
+
+// Let run_impulses() share DSP features between impulses that run on the same window,
+// see ei_feature_cache.h. SIZE is the number of DSP blocks kept per window.
+#ifndef EI_CLASSIFIER_FEATURE_CACHE
+#define EI_CLASSIFIER_FEATURE_CACHE                 0
+#endif // EI_CLASSIFIER_FEATURE_CACHE
+
+#ifndef EI_CLASSIFIER_FEATURE_CACHE_SIZE
+#define EI_CLASSIFIER_FEATURE_CACHE_SIZE            4
+#endif // EI_CLASSIFIER_FEATURE_CACHE_SIZE
+
 // no include checks in the compiler? then just include metadata and then ops_define (optional if on EON model)
 #ifndef __has_include
     #include "model-parameters/model_metadata.h"
@@ -42,6 +42,7 @@
 typedef struct ei_classifier_smooth {
     int *last_readings;
     size_t last_readings_size;
+    size_t last_readings_ix; // oldest reading, replaced by the next one
     uint8_t min_readings_same;
     float classifier_confidence;
     float anomaly_confidence;
@@ -49,13 +50,29 @@ typedef struct ei_classifier_smooth {
     size_t count_size = EI_CLASSIFIER_LABEL_COUNT + 2;
 } ei_classifier_smooth_t;
 
+/**
+ * Smoothed readings turned into events. A label is only reported when the
+ * smoothed reading changes, and after it was the same for `debounce` updates.
+ * The reported label keeps being read while its score stays above
+ * `exit_confidence` (lower than the confidence needed to enter it), and an
+ * anomaly overrides the labels.
+ */
+typedef struct ei_classifier_event {
+    ei_classifier_smooth_t smooth;
+    float exit_confidence;
+    uint8_t debounce;
+    int state; // reported reading, -1 == uncertain, -2 == anomaly
+    int candidate;
+    uint8_t candidate_count;
+} ei_classifier_event_t;
+
 /**
  * Initialize a smooth structure. This is useful if you don't want to trust
  * single readings, but rather want consensus
  * (e.g. 7 / 10 readings should be the same before I draw any ML conclusions).
  * This allocates memory on the heap!
  * @param smooth Pointer to an uninitialized ei_classifier_smooth_t struct
- * @param n_readings Number of readings you want to store
+ * @param n_readings Number of readings you want to store (max. 255)
  * @param min_readings_same Minimum readings that need to be the same before concluding (needs to be lower than n_readings)
  * @param classifier_confidence Minimum confidence in a class (default 0.8)
  * @param anomaly_confidence Maximum error for anomalies (default 0.3)
@@ -68,10 +85,72 @@ void ei_classifier_smooth_init(ei_classifier_smooth_t *smooth, size_t n_readings
         smooth->last_readings[ix] = -1; // -1 == uncertain
     }
     smooth->last_readings_size = n_readings;
+    smooth->last_readings_ix = 0;
     smooth->min_readings_same = min_readings_same;
     smooth->classifier_confidence = classifier_confidence;
     smooth->anomaly_confidence = anomaly_confidence;
     smooth->count_size = EI_CLASSIFIER_LABEL_COUNT + 2;
+    memset(smooth->count, 0, EI_CLASSIFIER_LABEL_COUNT + 2);
+    smooth->count[EI_CLASSIFIER_LABEL_COUNT] = (uint8_t)n_readings;
+}
+
+/**
+ * Index in the count array: labels, then uncertain (-1) and anomaly (-2)
+ */
+static inline size_t ei_classifier_smooth_count_ix(int reading) {
+    if (reading >= 0) {
+        return (size_t)reading;
+    }
+    return reading == -1 ? EI_CLASSIFIER_LABEL_COUNT : EI_CLASSIFIER_LABEL_COUNT + 1;
+}
+
+/**
+ * Replace the oldest reading and update the counts, then pick the most frequent reading.
+ * @returns Label index, -1 (uncertain) or -2 (anomaly)
+ */
+int ei_classifier_smooth_add_reading(ei_classifier_smooth_t *smooth, int reading) {
+    int *oldest = &smooth->last_readings[smooth->last_readings_ix];
+    smooth->count[ei_classifier_smooth_count_ix(*oldest)]--;
+    smooth->count[ei_classifier_smooth_count_ix(reading)]++;
+    *oldest = reading;
+    smooth->last_readings_ix = (smooth->last_readings_ix + 1) % smooth->last_readings_size;
+
+    // then loop over the count and see which is highest
+    uint8_t top_result = 0;
+    uint8_t top_count = 0;
+    bool met_confidence_threshold = false;
+    uint8_t confidence_threshold = smooth->min_readings_same; // XX% of windows should be the same
+    for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT + 2; ix++) {
+        if (smooth->count[ix] > top_count) {
+            top_result = ix;
+            top_count = smooth->count[ix];
+        }
+        if (smooth->count[ix] >= confidence_threshold) {
+            met_confidence_threshold = true;
+        }
+    }
+
+    if (!met_confidence_threshold || top_result == EI_CLASSIFIER_LABEL_COUNT) {
+        return -1;
+    }
+    if (top_result == EI_CLASSIFIER_LABEL_COUNT + 1) {
+        return -2;
+    }
+    return (int)top_result;
+}
+
+/**
+ * Label of a reading
+ * @returns 'uncertain', 'anomaly', or a label from the result struct
+ */
+const char* ei_classifier_smooth_label(int reading, ei_impulse_result_t *result) {
+    if (reading == -1) {
+        return "uncertain";
+    }
+    else if (reading == -2) {
+        return "anomaly";
+    }
+    return result->classification[reading].label;
 }
 
 /**
@@ -81,16 +160,8 @@ void ei_classifier_smooth_init(ei_classifier_smooth_t *smooth, size_t n_readings
  * @returns Label, either 'uncertain', 'anomaly', or a label from the result struct
  */
 const char* ei_classifier_smooth_update(ei_classifier_smooth_t *smooth, ei_impulse_result_t *result) {
-    // clear out the count array
-    memset(smooth->count, 0, EI_CLASSIFIER_LABEL_COUNT + 2);
-
-    // roll through the last_readings buffer
-    numpy::roll(smooth->last_readings, smooth->last_readings_size, -1);
-
     int reading = -1; // uncertain
 
-    // print the predictions
-    // printf("[");
     for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
         if (result->classification[ix].value >= smooth->classifier_confidence) {
             reading = (int)ix;
@@ -102,55 +173,100 @@ const char* ei_classifier_smooth_update(ei_classifier_smooth_t *smooth, ei_impul
     }
 #endif
 
-    smooth->last_readings[smooth->last_readings_size - 1] = reading;
+    return ei_classifier_smooth_label(ei_classifier_smooth_add_reading(smooth, reading), result);
+}
 
-    // now count last 10 readings and see what we actually see...
-    for (size_t ix = 0; ix < smooth->last_readings_size; ix++) {
-        if (smooth->last_readings[ix] >= 0) {
-            smooth->count[smooth->last_readings[ix]]++;
-        }
-        else if (smooth->last_readings[ix] == -1) { // uncertain
-            smooth->count[EI_CLASSIFIER_LABEL_COUNT]++;
-        }
-        else if (smooth->last_readings[ix] == -2) { // anomaly
-            smooth->count[EI_CLASSIFIER_LABEL_COUNT + 1]++;
+/**
+ * Clear up a smooth structure
+ */
+void ei_classifier_smooth_free(ei_classifier_smooth_t *smooth) {
+    ei_free(smooth->last_readings);
+}
+
+/**
+ * Initialize an event structure. This allocates memory on the heap!
+ * @param event Pointer to an uninitialized ei_classifier_event_t struct
+ * @param n_readings Number of readings the smoothing is done on (max. 255)
+ * @param min_readings_same Minimum readings that need to be the same before concluding
+ * @param debounce Number of updates the smoothed reading needs to be the same before it's reported
+ * @param enter_confidence Minimum confidence in a class to start reading it (default 0.8)
+ * @param exit_confidence Minimum confidence in the reported class to keep reading it (default 0.6)
+ * @param anomaly_confidence Maximum error for anomalies (default 0.3)
+ */
+void ei_classifier_event_init(ei_classifier_event_t *event, size_t n_readings,
+                              uint8_t min_readings_same, uint8_t debounce,
+                              float enter_confidence = 0.8, float exit_confidence = 0.6,
+                              float anomaly_confidence = 0.3) {
+    ei_classifier_smooth_init(&event->smooth, n_readings, min_readings_same,
+                              enter_confidence, anomaly_confidence);
+    event->exit_confidence = exit_confidence;
+    event->debounce = debounce > 0 ? debounce : 1;
+    event->state = -1;
+    event->candidate = -1;
+    event->candidate_count = 0;
+}
+
+/**
+ * Call when a new reading comes in.
+ * @param event Pointer to an initialized ei_classifier_event_t struct
+ * @param result Pointer to a result structure (after calling ei_run_classifier)
+ * @returns true if the reported reading changed, get it with ei_classifier_event_label()
+ */
+bool ei_classifier_event_update(ei_classifier_event_t *event, ei_impulse_result_t *result) {
+    int reading = -1; // uncertain
+
+#if EI_CLASSIFIER_HAS_ANOMALY
+    if (result->anomaly >= event->smooth.anomaly_confidence) {
+        reading = -2; // anomaly, the classification of an anomalous window isn't trusted
+    }
+    else
+#endif
+    if (event->state >= 0 &&
+        result->classification[event->state].value >= event->exit_confidence) {
+        reading = event->state;
+    }
+    else {
+        float top_value = event->smooth.classifier_confidence;
+        for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+            if (result->classification[ix].value >= top_value) {
+                reading = (int)ix;
+                top_value = result->classification[ix].value;
+            }
         }
     }
 
-    // then loop over the count and see which is highest
-    uint8_t top_result = 0;
-    uint8_t top_count = 0;
-    bool met_confidence_threshold = false;
-    uint8_t confidence_threshold = smooth->min_readings_same; // XX% of windows should be the same
-    for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT + 2; ix++) {
-        if (smooth->count[ix] > top_count) {
-            top_result = ix;
-            top_count = smooth->count[ix];
-        }
-        if (smooth->count[ix] >= confidence_threshold) {
-            met_confidence_threshold = true;
-        }
+    int smoothed = ei_classifier_smooth_add_reading(&event->smooth, reading);
+    if (smoothed == event->state) {
+        event->candidate_count = 0;
+        return false;
     }
 
-    if (met_confidence_threshold) {
-        if (top_result == EI_CLASSIFIER_LABEL_COUNT) {
-            return "uncertain";
-        }
-        else if (top_result == EI_CLASSIFIER_LABEL_COUNT + 1) {
-            return "anomaly";
-        }
-        else {
-            return result->classification[top_result].label;
-        }
+    if (smoothed != event->candidate) {
+        event->candidate = smoothed;
+        event->candidate_count = 0;
+    }
+    if (++event->candidate_count < event->debounce) {
+        return false;
     }
-    return "uncertain";
+
+    event->state = smoothed;
+    event->candidate_count = 0;
+    return true;
 }
 
 /**
- * Clear up a smooth structure
+ * Reported reading of an event structure
+ * @returns Label, either 'uncertain', 'anomaly', or a label from the result struct
  */
-void ei_classifier_smooth_free(ei_classifier_smooth_t *smooth) {
-    ei_free(smooth->last_readings);
+const char* ei_classifier_event_label(ei_classifier_event_t *event, ei_impulse_result_t *result) {
+    return ei_classifier_smooth_label(event->state, result);
+}
+
+/**
+ * Clear up an event structure
+ */
+void ei_classifier_event_free(ei_classifier_event_t *event) {
+    ei_classifier_smooth_free(&event->smooth);
 }
 
 #endif // #if EI_CLASSIFIER_OBJECT_DETECTION != 1
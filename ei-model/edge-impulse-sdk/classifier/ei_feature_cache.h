@@ -0,0 +1,238 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_FEATURE_CACHE_H_
+#define _EI_CLASSIFIER_FEATURE_CACHE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/classifier/ei_run_dsp.h"
+#include "edge-impulse-sdk/dsp/memory.hpp"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+namespace ei {
+
+/**
+ * DSP features of one window of sensor data, shared by all impulses that run on it (see
+ * run_impulses). Entries are keyed by a hash of the DSP block (function, config, axes,
+ * frequency) and dropped when the window changes, so each DSP block runs once per window.
+ * Entries also record the signal and window they were computed from, a hit needs all of
+ * them to match, not only the 32 bit hash.
+ * The cache also holds the scratch arena the impulses share.
+ */
+class ei_feature_cache_t {
+public:
+    ei_feature_cache_t() : window_id(0), hits(0), misses(0) {
+        memset(entries, 0, sizeof(entries));
+    }
+
+    ~ei_feature_cache_t() {
+        for (size_t ix = 0; ix < EI_CLASSIFIER_FEATURE_CACHE_SIZE; ix++) {
+            if (entries[ix].buffer) {
+                ei_free(entries[ix].buffer);
+            }
+        }
+    }
+
+    /**
+     * Start a new window, features of any other window are dropped
+     * @param id Identifies the window, e.g. the index of its first sample
+     */
+    void begin_window(uint64_t id) {
+        if (id != window_id) {
+            for (size_t ix = 0; ix < EI_CLASSIFIER_FEATURE_CACHE_SIZE; ix++) {
+                entries[ix].valid = false;
+            }
+            window_id = id;
+        }
+    }
+
+    /**
+     * Copy the cached features of a DSP block into matrix
+     * @param key Key of the block, see ei_feature_cache_key
+     * @param signal Signal the features are extracted from
+     * @returns true if found
+     */
+    bool lookup(uint32_t key, const signal_t *signal, matrix_t *matrix) {
+        size_t count = matrix->rows * matrix->cols;
+
+        for (size_t ix = 0; ix < EI_CLASSIFIER_FEATURE_CACHE_SIZE; ix++) {
+            const entry_t &entry = entries[ix];
+            if (entry.valid && entry.key == key && entry.count == count &&
+                entry.window_id == window_id && entry.signal == signal &&
+                entry.signal_length == signal->total_length) {
+                memcpy(matrix->buffer, entry.buffer, count * sizeof(float));
+                hits++;
+                return true;
+            }
+        }
+        misses++;
+        return false;
+    }
+
+    /**
+     * Keep the features of a DSP block for the current window. Nothing is stored if
+     * the cache is full or out of memory, the block just runs again.
+     */
+    void store(uint32_t key, const signal_t *signal, const matrix_t *matrix) {
+        size_t count = matrix->rows * matrix->cols;
+
+        for (size_t ix = 0; ix < EI_CLASSIFIER_FEATURE_CACHE_SIZE; ix++) {
+            entry_t &entry = entries[ix];
+            if (entry.valid) {
+                continue;
+            }
+            // buffers are kept between windows, only grow them
+            if (entry.capacity < count) {
+                if (entry.buffer) {
+                    ei_free(entry.buffer);
+                }
+                entry.buffer = (float *)ei_malloc(count * sizeof(float));
+                entry.capacity = entry.buffer ? count : 0;
+                if (!entry.buffer) {
+                    return;
+                }
+            }
+            memcpy(entry.buffer, matrix->buffer, count * sizeof(float));
+            entry.key = key;
+            entry.window_id = window_id;
+            entry.signal = signal;
+            entry.signal_length = signal->total_length;
+            entry.count = count;
+            entry.valid = true;
+            return;
+        }
+    }
+
+    uint32_t get_hits() const {
+        return hits;
+    }
+
+    uint32_t get_misses() const {
+        return misses;
+    }
+
+    /**
+     * The cache process_impulse uses, set while run_impulses runs. Process-wide like
+     * ei_arena_t::active(), so run_impulses must not run on two threads at once.
+     */
+    static ei_feature_cache_t *&active() {
+        static ei_feature_cache_t *active_cache = nullptr;
+        return active_cache;
+    }
+
+    // scratch memory of process_impulse for all impulses, see EI_CLASSIFIER_IMPULSE_ARENA
+    ei_arena_t arena;
+
+private:
+    typedef struct {
+        uint32_t key;
+        bool valid;
+        uint64_t window_id;
+        const signal_t *signal;
+        size_t signal_length;
+        size_t count;
+        size_t capacity;
+        float *buffer;
+    } entry_t;
+
+    entry_t entries[EI_CLASSIFIER_FEATURE_CACHE_SIZE];
+    uint64_t window_id;
+    uint32_t hits;
+    uint32_t misses;
+};
+
+/**
+ * FNV-1a, over the block properties that determine its features
+ */
+static inline uint32_t ei_feature_cache_hash(uint32_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t ix = 0; ix < size; ix++) {
+        hash = (hash ^ bytes[ix]) * 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t ei_feature_cache_hash_str(uint32_t hash, const char *str)
+{
+    return str ? ei_feature_cache_hash(hash, str, strlen(str) + 1) : ei_feature_cache_hash(hash, "", 1);
+}
+
+/**
+ * Key of a DSP block in the feature cache. Spectral analysis configs are compared by value
+ * (ignoring the block id), so identical blocks of different impulses share their features.
+ * Other blocks are only shared if they use the same config struct.
+ */
+static inline uint32_t ei_feature_cache_key(const ei_model_dsp_t *block, float frequency)
+{
+    uint32_t hash = 2166136261u;
+
+    hash = ei_feature_cache_hash(hash, &block->extract_fn, sizeof(block->extract_fn));
+    hash = ei_feature_cache_hash(hash, &block->n_output_features, sizeof(block->n_output_features));
+    hash = ei_feature_cache_hash(hash, block->axes, block->axes_size * sizeof(block->axes[0]));
+    hash = ei_feature_cache_hash(hash, &frequency, sizeof(frequency));
+
+    if (block->extract_fn == &extract_spectral_analysis_features) {
+        const ei_dsp_config_spectral_analysis_t *config = (const ei_dsp_config_spectral_analysis_t *)block->config;
+        hash = ei_feature_cache_hash(hash, &config->implementation_version, sizeof(config->implementation_version));
+        hash = ei_feature_cache_hash(hash, &config->axes, sizeof(config->axes));
+        hash = ei_feature_cache_hash(hash, &config->scale_axes, sizeof(config->scale_axes));
+        hash = ei_feature_cache_hash(hash, &config->input_decimation_ratio, sizeof(config->input_decimation_ratio));
+        hash = ei_feature_cache_hash_str(hash, config->filter_type);
+        hash = ei_feature_cache_hash(hash, &config->filter_cutoff, sizeof(config->filter_cutoff));
+        hash = ei_feature_cache_hash(hash, &config->filter_order, sizeof(config->filter_order));
+        hash = ei_feature_cache_hash_str(hash, config->analysis_type);
+        hash = ei_feature_cache_hash(hash, &config->fft_length, sizeof(config->fft_length));
+        hash = ei_feature_cache_hash(hash, &config->spectral_peaks_count, sizeof(config->spectral_peaks_count));
+        hash = ei_feature_cache_hash(hash, &config->spectral_peaks_threshold, sizeof(config->spectral_peaks_threshold));
+        hash = ei_feature_cache_hash_str(hash, config->spectral_power_edges);
+        hash = ei_feature_cache_hash(hash, &config->do_log, sizeof(config->do_log));
+        hash = ei_feature_cache_hash(hash, &config->do_fft_overlap, sizeof(config->do_fft_overlap));
+        hash = ei_feature_cache_hash(hash, &config->wavelet_level, sizeof(config->wavelet_level));
+        hash = ei_feature_cache_hash_str(hash, config->wavelet);
+        hash = ei_feature_cache_hash(hash, &config->extra_low_freq, sizeof(config->extra_low_freq));
+    }
+    else {
+        hash = ei_feature_cache_hash(hash, &block->config, sizeof(block->config));
+    }
+
+    return hash;
+}
+
+} // namespace ei
+
+#endif // _EI_CLASSIFIER_FEATURE_CACHE_H_
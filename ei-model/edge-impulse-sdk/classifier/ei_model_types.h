@@ -423,6 +423,7 @@ public:
     ei_impulse_state_t state;
     const ei_impulse_t *impulse;
     void** post_processing_state;
+    ei::ei_arena_t arena; // scratch memory of process_impulse, see EI_CLASSIFIER_IMPULSE_ARENA
 };
 
 typedef struct {
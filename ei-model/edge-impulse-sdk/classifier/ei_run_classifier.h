@@ -37,6 +37,7 @@
 
 #include "ei_model_types.h"
 #include "model-parameters/model_metadata.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
 
 #include "ei_run_dsp.h"
 #include "ei_classifier_types.h"
@@ -46,7 +47,12 @@
 
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "edge-impulse-sdk/porting/ei_logging.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
+#if EI_CLASSIFIER_FEATURE_CACHE
+#include "edge-impulse-sdk/classifier/ei_feature_cache.h"
+#endif
 #include <memory>
+#include <new>
 
 #if EI_CLASSIFIER_HAS_ANOMALY
 #include "inferencing_engines/anomaly.h"
@@ -99,6 +105,10 @@ namespace {
 extern "C" EI_IMPULSE_ERROR run_inference(ei_impulse_handle_t *handle, ei_feature_t *fmatrix, ei_impulse_result_t *result, bool debug);
 extern "C" EI_IMPULSE_ERROR run_classifier_image_quantized(const ei_impulse_t *impulse, signal_t *signal, ei_impulse_result_t *result, bool debug);
 static EI_IMPULSE_ERROR can_run_classifier_image_quantized(const ei_impulse_t *impulse, ei_learning_block_t block_ptr);
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1 && EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && EI_CLASSIFIER_COMPILED == 1
+extern "C" EI_IMPULSE_ERROR run_classifier_spectral_quantized(const ei_impulse_t *impulse, signal_t *signal, ei_impulse_result_t *result, bool debug);
+static EI_IMPULSE_ERROR can_run_classifier_spectral_quantized(const ei_impulse_t *impulse);
+#endif // EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1 && EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && EI_CLASSIFIER_COMPILED == 1
 
 #if EI_CLASSIFIER_LOAD_IMAGE_SCALING
 EI_IMPULSE_ERROR ei_scale_fmatrix(ei_learning_block_t *block, ei::matrix_t *fmatrix);
@@ -238,6 +248,102 @@ extern "C" EI_IMPULSE_ERROR run_inference(
     return EI_IMPULSE_OK;
 }
 
+#if EI_CLASSIFIER_IMPULSE_ARENA
+/**
+ * @brief      Get the size of the scratch arena for an impulse. Unless set through
+ *             EI_CLASSIFIER_IMPULSE_ARENA_SIZE this covers the feature matrices, plus
+ *             two copies of the DSP input for the blocks to transform it.
+ *
+ * @param      impulse  struct with information about model and DSP
+ *
+ * @return     Arena size in bytes
+ */
+static size_t get_impulse_arena_size(const ei_impulse_t *impulse)
+{
+#if EI_CLASSIFIER_IMPULSE_ARENA_SIZE > 0
+    (void)impulse;
+    return EI_CLASSIFIER_IMPULSE_ARENA_SIZE;
+#else
+    auto aligned = ei::ei_arena_t::aligned_size;
+
+    const size_t block_num = impulse->dsp_blocks_size + impulse->learning_blocks_size;
+    size_t size = aligned(sizeof(ei_feature_t) * block_num);
+
+    for (size_t ix = 0; ix < impulse->dsp_blocks_size; ix++) {
+        size += aligned(sizeof(ei::matrix_t)) +
+            aligned(impulse->dsp_blocks[ix].n_output_features * sizeof(float));
+    }
+    for (size_t ix = 0; ix < impulse->learning_blocks_size; ix++) {
+        if (impulse->learning_blocks[ix].keep_output) {
+            size += aligned(sizeof(ei::matrix_t)) +
+                aligned(impulse->learning_blocks[ix].output_features_count * sizeof(float));
+        }
+    }
+
+    size += 2 * aligned(impulse->dsp_input_frame_size * sizeof(float));
+
+    // small temporaries (means, per-row results, ...)
+    size += 32 * ei::ei_arena_t::alignment;
+
+    return size;
+#endif // EI_CLASSIFIER_IMPULSE_ARENA_SIZE > 0
+}
+
+/**
+ * @brief      Allocate the arena on first use and reset it for a new run. If it can't be
+ *             allocated all scratch memory comes from the heap, as without the arena.
+ *
+ * @param      handle  struct with information about model and DSP
+ *
+ * @return     The arena of the handle, or the shared one while run_impulses runs
+ */
+static ei::ei_arena_t *prepare_impulse_arena(ei_impulse_handle_t *handle)
+{
+    ei::ei_arena_t *arena = &handle->arena;
+#if EI_CLASSIFIER_FEATURE_CACHE
+    if (ei::ei_feature_cache_t::active()) {
+        arena = &ei::ei_feature_cache_t::active()->arena;
+    }
+#endif
+
+    if (!arena->is_initialized()) {
+        if (!arena->init(get_impulse_arena_size(handle->impulse))) {
+            EI_LOGW("Failed to allocate impulse arena, using the heap\n");
+        }
+    }
+    arena->reset();
+    return arena;
+}
+#endif // EI_CLASSIFIER_IMPULSE_ARENA
+
+/**
+ * @brief      Create a feature matrix. While the impulse arena is active both the matrix
+ *             and its buffer are taken from it, otherwise the matrix is owned by owner.
+ *
+ * @param      owner  Takes ownership of the matrix when it's allocated on the heap
+ * @param[in]  rows   Number of rows
+ * @param[in]  cols   Number of columns
+ *
+ * @return     The matrix, or nullptr if out of memory
+ */
+static ei::matrix_t *create_feature_matrix(std::unique_ptr<ei::matrix_t> &owner, uint32_t rows, uint32_t cols)
+{
+    ei::ei_arena_t *arena = ei::ei_arena_t::active();
+    // both requests are rounded up by the arena. If the buffer didn't fit after the matrix it
+    // would come from the heap, and the matrix isn't destructed so it would leak.
+    const size_t needed = ei::ei_arena_t::aligned_size(sizeof(ei::matrix_t)) +
+        ei::ei_arena_t::aligned_size(rows * cols * sizeof(float));
+
+    if (arena && arena->available() >= needed) {
+        // buffers from the arena are not freed by the matrix, so no need to destruct it
+        void *mem = arena->calloc(sizeof(ei::matrix_t));
+        return new (mem) ei::matrix_t(rows, cols);
+    }
+
+    owner = std::unique_ptr<ei::matrix_t>(new ei::matrix_t(rows, cols));
+    return owner.get();
+}
+
 /**
  * @brief      Process a complete impulse
  *
@@ -254,6 +360,8 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
                                             ei_impulse_result_t *result,
                                             bool debug = false)
 {
+    EI_TRACE_ZONE("process_impulse");
+
     if ((handle == nullptr) || (handle->impulse  == nullptr) || (result  == nullptr) || (signal  == nullptr)) {
         return EI_IMPULSE_INFERENCE_ERROR;
     }
@@ -271,15 +379,42 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
     }
 #endif
 
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1 && EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && EI_CLASSIFIER_COMPILED == 1
+    // Shortcut for a spectral analysis block in front of a quantized EON model, its
+    // features are not shared through the feature cache
+    bool spectral_quantized = can_run_classifier_spectral_quantized(handle->impulse) == EI_IMPULSE_OK;
+#if EI_CLASSIFIER_FEATURE_CACHE
+    spectral_quantized = spectral_quantized && ei::ei_feature_cache_t::active() == nullptr;
+#endif
+    if (spectral_quantized) {
+        EI_IMPULSE_ERROR res = run_classifier_spectral_quantized(handle->impulse, signal, result, debug);
+        if (res != EI_IMPULSE_OK) {
+            return res;
+        }
+        // postprocessing keeps state between runs, keep it out of the impulse arena
+        ei::ei_arena_scope_t no_arena(nullptr);
+        return run_postprocessing(handle, result);
+    }
+#endif
+
 #ifndef EI_DSP_RESULT_OVERRIDE
     // Don't wipe in CI, as we store a pointer
     memset(result, 0, sizeof(ei_impulse_result_t));
 #endif
     uint32_t block_num = handle->impulse->dsp_blocks_size + handle->impulse->learning_blocks_size;
 
-    // smart pointer to features array
-    std::unique_ptr<ei_feature_t[]> features_ptr(new ei_feature_t[block_num]);
-    ei_feature_t* features = features_ptr.get();
+#if EI_CLASSIFIER_IMPULSE_ARENA
+    ei::ei_arena_t *arena = prepare_impulse_arena(handle);
+    ei::ei_arena_scope_t arena_scope(arena);
+#endif
+
+    // features array, from the impulse arena if it's active
+    std::unique_ptr<ei_feature_t[]> features_ptr;
+    ei_feature_t* features = (ei_feature_t*)ei::ei_arena_t::scratch_calloc(sizeof(ei_feature_t) * block_num);
+    if (features == nullptr) {
+        features_ptr = std::unique_ptr<ei_feature_t[]>(new ei_feature_t[block_num]);
+        features = features_ptr.get();
+    }
 
     if (features == nullptr) {
         ei_printf("ERR: Out of memory, can't allocate features\n");
@@ -302,22 +437,26 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
 
     size_t out_features_index = 0;
 
+#if EI_CLASSIFIER_FEATURE_CACHE
+    ei::ei_feature_cache_t *cache = ei::ei_feature_cache_t::active();
+#endif
+
     for (size_t ix = 0; ix < handle->impulse->dsp_blocks_size; ix++) {
         ei_model_dsp_t block = handle->impulse->dsp_blocks[ix];
+        EI_TRACE_ZONE("dsp");
 
-        matrix_ptrs[ix] = std::unique_ptr<ei::matrix_t>(new ei::matrix_t(1, block.n_output_features));
-        if (matrix_ptrs[ix] == nullptr) {
+        ei::matrix_t *matrix = create_feature_matrix(matrix_ptrs[ix], 1, block.n_output_features);
+        if (matrix == nullptr) {
             ei_printf("ERR: Out of memory, can't allocate matrix_ptrs[%lu]\n", (unsigned long)ix);
             return EI_IMPULSE_ALLOC_FAILED;
         }
 
-        if (matrix_ptrs[ix]->buffer == nullptr) {
+        if (matrix->buffer == nullptr) {
             ei_printf("ERR: Out of memory, can't allocate matrix_ptrs[%lu]\n", (unsigned long)ix);
-            delete[] matrix_ptrs;
             return EI_IMPULSE_ALLOC_FAILED;
         }
 
-        features[ix].matrix = matrix_ptrs[ix].get();
+        features[ix].matrix = matrix;
         features[ix].blockId = block.blockId;
 
         if (out_features_index + block.n_output_features > handle->impulse->nn_input_frame_size) {
@@ -325,6 +464,18 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
             return EI_IMPULSE_DSP_ERROR;
         }
 
+#if EI_CLASSIFIER_FEATURE_CACHE
+        // blocks with state can't be shared, their features depend on earlier windows
+        uint32_t cache_key = 0;
+        if (cache && !block.factory) {
+            cache_key = ei::ei_feature_cache_key(&block, handle->impulse->frequency);
+            if (cache->lookup(cache_key, signal, matrix)) {
+                out_features_index += block.n_output_features;
+                continue;
+            }
+        }
+#endif
+
 #if EIDSP_SIGNAL_C_FN_POINTER
         if (block.axes_size != handle->impulse->raw_samples_per_frame) {
             ei_printf("ERR: EIDSP_SIGNAL_C_FN_POINTER can only be used when all axes are selected for DSP blocks\n");
@@ -345,6 +496,9 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
                 has_printed = true;
             }
 
+            // the block state outlives this run, keep it out of the impulse arena
+            ei::ei_arena_scope_t no_arena(nullptr);
+
             // getter has a lazy init, so we can just call it
             auto dsp_handle = handle->state.get_dsp_handle(ix);
             if(dsp_handle) {
@@ -367,6 +521,12 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
             return EI_IMPULSE_DSP_ERROR;
         }
 
+#if EI_CLASSIFIER_FEATURE_CACHE
+        if (cache && !block.factory) {
+            cache->store(cache_key, signal, matrix);
+        }
+#endif
+
         if (ei_run_impulse_check_canceled() == EI_IMPULSE_CANCELED) {
             return EI_IMPULSE_CANCELED;
         }
@@ -387,8 +547,8 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
         ei_learning_block_t block = handle->impulse->learning_blocks[ix];
 
         if (block.keep_output) {
-            matrix_ptrs[handle->impulse->dsp_blocks_size + ix] = std::unique_ptr<ei::matrix_t>(new ei::matrix_t(1, block.output_features_count));
-            features[handle->impulse->dsp_blocks_size + ix].matrix = matrix_ptrs[handle->impulse->dsp_blocks_size + ix].get();
+            features[handle->impulse->dsp_blocks_size + ix].matrix = create_feature_matrix(
+                matrix_ptrs[handle->impulse->dsp_blocks_size + ix], 1, block.output_features_count);
             features[handle->impulse->dsp_blocks_size + ix].blockId = block.blockId;
         }
     }
@@ -419,9 +579,20 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
     return EI_IMPULSE_OK;
 #else
     EI_IMPULSE_ERROR res = run_inference(handle, features, result, debug);
+
+#if EI_CLASSIFIER_IMPULSE_ARENA
+    if (debug) {
+        ei_printf("Impulse arena: %u of %u bytes used, peak demand %u bytes, %u bytes from heap\n",
+            (unsigned int)arena->get_used(), (unsigned int)arena->get_size(),
+            (unsigned int)arena->get_peak(), (unsigned int)arena->get_heap_fallback_bytes());
+    }
+#endif
+
     if (res != EI_IMPULSE_OK) {
         return res;
     } else {
+        // postprocessing keeps state between runs, keep it out of the impulse arena
+        ei::ei_arena_scope_t no_arena(nullptr);
         return run_postprocessing(handle, result);
     }
 #endif
@@ -439,6 +610,9 @@ extern "C" EI_IMPULSE_ERROR init_impulse(ei_impulse_handle_t *handle) {
         return EI_IMPULSE_OUT_OF_MEMORY;
     }
     handle->state.reset();
+#if EI_CLASSIFIER_IMPULSE_ARENA
+    prepare_impulse_arena(handle);
+#endif
     return EI_IMPULSE_OK;
 }
 
@@ -457,6 +631,8 @@ extern "C" EI_IMPULSE_ERROR process_impulse_continuous(ei_impulse_handle_t *hand
                                             ei_impulse_result_t *result,
                                             bool debug = false)
 {
+    EI_TRACE_ZONE("process_impulse_continuous");
+
     if ((handle == nullptr) || (handle->impulse  == nullptr) || (result  == nullptr) || (signal  == nullptr)) {
         return EI_IMPULSE_INFERENCE_ERROR;
     }
@@ -467,6 +643,11 @@ extern "C" EI_IMPULSE_ERROR process_impulse_continuous(ei_impulse_handle_t *hand
         return EI_IMPULSE_ALLOC_FAILED;
     }
 
+#if EI_CLASSIFIER_IMPULSE_ARENA
+    ei::ei_arena_t *arena = prepare_impulse_arena(handle);
+    ei::ei_arena_scope_t arena_scope(arena);
+#endif
+
     memset(result, 0, sizeof(ei_impulse_result_t));
 
     EI_IMPULSE_ERROR ei_impulse_error = EI_IMPULSE_OK;
@@ -477,6 +658,7 @@ extern "C" EI_IMPULSE_ERROR process_impulse_continuous(ei_impulse_handle_t *hand
 
     for (size_t ix = 0; ix < impulse->dsp_blocks_size; ix++) {
         ei_model_dsp_t block = impulse->dsp_blocks[ix];
+        EI_TRACE_ZONE("dsp");
 
         if (out_features_index + block.n_output_features > impulse->nn_input_frame_size) {
             ei_printf("ERR: Would write outside feature buffer\n");
@@ -498,8 +680,11 @@ extern "C" EI_IMPULSE_ERROR process_impulse_continuous(ei_impulse_handle_t *hand
         else if (block.extract_fn == extract_mfe_features) {
             extract_fn_slice = &extract_mfe_per_slice_features;
         }
+        else if (block.extract_fn == extract_spectral_analysis_features) {
+            extract_fn_slice = &extract_spectral_analysis_per_slice_features;
+        }
         else {
-            ei_printf("ERR: Unknown extract function, only MFCC, MFE and spectrogram supported\n");
+            ei_printf("ERR: Unknown extract function, only MFCC, MFE, spectrogram and spectral analysis supported\n");
             return EI_IMPULSE_DSP_ERROR;
         }
 
@@ -611,6 +796,8 @@ extern "C" EI_IMPULSE_ERROR process_impulse_continuous(ei_impulse_handle_t *hand
 
         ei_impulse_error = run_inference(handle, features, result, debug);
         delete[] matrix_ptrs;
+        // postprocessing keeps state between runs, keep it out of the impulse arena
+        ei::ei_arena_scope_t no_arena(nullptr);
         ei_impulse_error = run_postprocessing(handle, result);
     }
 
@@ -675,6 +862,111 @@ extern "C" EI_IMPULSE_ERROR run_classifier_image_quantized(
 
 #endif // #if EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE || EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TENSAIFLOW || EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_DRPAI)
 
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1 && EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && EI_CLASSIFIER_COMPILED == 1
+/**
+ * Check if the current impulse could be used by 'run_classifier_spectral_quantized': one
+ * spectral analysis block over all axes that feature_q15 supports, feeding a quantized EON
+ * model. Other learning blocks (e.g. anomaly) still get float features.
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR can_run_classifier_spectral_quantized(const ei_impulse_t *impulse) {
+
+#if EI_CLASSIFIER_HAS_DATA_NORMALIZATION
+    return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+#endif
+
+    if (impulse->dsp_blocks_size != 1 || impulse->learning_blocks_size < 1) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+
+    const ei_model_dsp_t &dsp = impulse->dsp_blocks[0];
+    if (dsp.extract_fn != extract_spectral_analysis_features || dsp.factory
+        || dsp.axes_size != impulse->raw_samples_per_frame
+        || dsp.n_output_features != impulse->nn_input_frame_size) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+
+    if (!ei::spectral::feature_q15::is_supported((ei_dsp_config_spectral_analysis_t *)dsp.config)) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+
+    // the first learning block is the quantized NN, its output is not consumed by other blocks
+    ei_learning_block_t nn = impulse->learning_blocks[0];
+    if (nn.infer_fn != run_nn_inference || nn.keep_output) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    ei_learning_block_config_tflite_graph_t *block_config = (ei_learning_block_config_tflite_graph_t*)nn.config;
+    if (block_config->quantized != 1) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+
+    for (size_t ix = 1; ix < impulse->learning_blocks_size; ix++) {
+        if (impulse->learning_blocks[ix].infer_fn == run_nn_inference) {
+            return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+        }
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Run the classifier with the spectral features computed in fixed point and quantized straight
+ * into the EON input tensor. Only works if 'can_run_classifier_spectral_quantized' returns
+ * EI_IMPULSE_OK.
+ */
+extern "C" EI_IMPULSE_ERROR run_classifier_spectral_quantized(
+    const ei_impulse_t *impulse,
+    signal_t *signal,
+    ei_impulse_result_t *result,
+    bool debug = false)
+{
+    memset(result, 0, sizeof(ei_impulse_result_t));
+
+    // float copy of the features, only needed for the other learning blocks
+    uint32_t block_num = impulse->dsp_blocks_size + impulse->learning_blocks_size;
+    std::unique_ptr<ei_feature_t[]> features_ptr(new ei_feature_t[block_num]);
+    ei_feature_t *features = features_ptr.get();
+    if (features == nullptr) {
+        ei_printf("ERR: Out of memory, can't allocate features\n");
+        return EI_IMPULSE_ALLOC_FAILED;
+    }
+    memset(features, 0, sizeof(ei_feature_t) * block_num);
+
+    std::unique_ptr<ei::matrix_t> matrix_ptr;
+    if (impulse->learning_blocks_size > 1) {
+        matrix_ptr = std::unique_ptr<ei::matrix_t>(new ei::matrix_t(1, impulse->dsp_blocks[0].n_output_features));
+        if (matrix_ptr->buffer == nullptr) {
+            ei_printf("ERR: Out of memory, can't allocate features\n");
+            return EI_IMPULSE_ALLOC_FAILED;
+        }
+        features[0].matrix = matrix_ptr.get();
+        features[0].blockId = impulse->dsp_blocks[0].blockId;
+    }
+
+    EI_IMPULSE_ERROR res = run_nn_inference_spectral_quantized(impulse, signal, result,
+        impulse->learning_blocks[0].config, features[0].matrix, debug);
+    if (res != EI_IMPULSE_OK) {
+        return res;
+    }
+
+    for (size_t ix = 1; ix < impulse->learning_blocks_size; ix++) {
+        ei_learning_block_t block = impulse->learning_blocks[ix];
+
+        result->copy_output = block.keep_output;
+
+        res = block.infer_fn(impulse, features, ix, (uint32_t*)block.input_block_ids, block.input_block_ids_size, result, block.config, debug);
+        if (res != EI_IMPULSE_OK) {
+            return res;
+        }
+    }
+
+    if (ei_run_impulse_check_canceled() == EI_IMPULSE_CANCELED) {
+        return EI_IMPULSE_CANCELED;
+    }
+
+    return EI_IMPULSE_OK;
+}
+#endif // EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1 && EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && EI_CLASSIFIER_COMPILED == 1
+
 #if EI_CLASSIFIER_LOAD_IMAGE_SCALING
 static const float torch_mean[] = { 0.485, 0.456, 0.406 };
 static const float torch_std[] = { 0.229, 0.224, 0.225 };
@@ -877,6 +1169,14 @@ __attribute__((unused)) void run_classifier_init(ei_impulse_handle_t *handle)
 extern "C" void run_classifier_deinit(void)
 {
     deinit_postprocessing(&ei_default_impulse);
+    ei::numpy::clear_fft_plans();
+#if EI_CLASSIFIER_HAS_ANOMALY
+    free_packed_clusters();
+#endif
+    ei_default_impulse.arena.release();
+#if (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE) && (EI_CLASSIFIER_COMPILED == 1)
+    tflite_eon_deinit();
+#endif
 }
 
 __attribute__((unused)) void run_classifier_deinit(ei_impulse_handle_t *handle)
@@ -884,6 +1184,14 @@ __attribute__((unused)) void run_classifier_deinit(ei_impulse_handle_t *handle)
     deinit_postprocessing(handle);
 #if EI_CLASSIFIER_HAS_DATA_NORMALIZATION
     deinit_data_normalization(handle);
+#endif
+    ei::numpy::clear_fft_plans();
+#if EI_CLASSIFIER_HAS_ANOMALY
+    free_packed_clusters();
+#endif
+    handle->arena.release();
+#if (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE) && (EI_CLASSIFIER_COMPILED == 1)
+    tflite_eon_deinit();
 #endif
 }
 
@@ -1066,6 +1374,71 @@ __attribute__((unused)) EI_IMPULSE_ERROR run_classifier(
     return process_impulse(impulse, signal, result, debug);
 }
 
+#if EI_CLASSIFIER_FEATURE_CACHE
+/**
+ * @brief Run several impulses on the same window of sensor data.
+ *
+ * DSP blocks that the impulses have in common (same function, config, axes and frequency)
+ * run once, the other impulses get their features from `cache`. All impulses use the
+ * scratch arena of the cache instead of their own. Blocks with state and the continuous
+ * mode are not shared.
+ *
+ * **Blocking**: yes
+ *
+ * @param[in] handles Impulses to run, in order
+ * @param[in] handles_size Number of impulses
+ * @param[in] signal Window of raw data, passed to every impulse
+ * @param[in] window_id Identifies the window, e.g. the index of its first sample. Cached
+ *  features of other windows are dropped.
+ * @param[out] results Array of `handles_size` results
+ * @param[in] cache Feature cache, keep it between windows to reuse its memory
+ * @param[in] debug Print internal preprocessing and inference debugging information via `ei_printf()`.
+ *
+ * @return Error code of the first impulse that failed, or `EI_IMPULSE_OK`.
+ */
+__attribute__((unused)) EI_IMPULSE_ERROR run_impulses(
+    ei_impulse_handle_t **handles,
+    size_t handles_size,
+    signal_t *signal,
+    uint64_t window_id,
+    ei_impulse_result_t *results,
+    ei::ei_feature_cache_t *cache,
+    bool debug = false)
+{
+    if ((handles == nullptr) || (results == nullptr) || (cache == nullptr)) {
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+
+#if EI_CLASSIFIER_IMPULSE_ARENA
+    // size the shared arena for the largest impulse
+    size_t arena_size = 0;
+    for (size_t ix = 0; ix < handles_size; ix++) {
+        if (handles[ix] && handles[ix]->impulse) {
+            size_t size = get_impulse_arena_size(handles[ix]->impulse);
+            arena_size = size > arena_size ? size : arena_size;
+        }
+    }
+    if (cache->arena.get_size() < arena_size && !cache->arena.init(arena_size)) {
+        EI_LOGW("Failed to allocate impulse arena, using the heap\n");
+    }
+#endif
+
+    cache->begin_window(window_id);
+
+    ei::ei_feature_cache_t *prev_cache = ei::ei_feature_cache_t::active();
+    ei::ei_feature_cache_t::active() = cache;
+
+    EI_IMPULSE_ERROR res = EI_IMPULSE_OK;
+    for (size_t ix = 0; ix < handles_size && res == EI_IMPULSE_OK; ix++) {
+        res = process_impulse(handles[ix], signal, &results[ix], debug);
+    }
+
+    ei::ei_feature_cache_t::active() = prev_cache;
+
+    return res;
+}
+#endif // EI_CLASSIFIER_FEATURE_CACHE
+
 /** @} */ // end of ei_functions Doxygen group
 
 /* Deprecated functions ------------------------------------------------------- */
@@ -37,6 +37,10 @@
 
 #include "edge-impulse-sdk/classifier/ei_model_types.h"
 #include "edge-impulse-sdk/dsp/spectral/spectral.hpp"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1
+#include "edge-impulse-sdk/dsp/spectral/feature_q15.hpp"
+#endif
 #include "edge-impulse-sdk/dsp/speechpy/speechpy.hpp"
 #include "edge-impulse-sdk/classifier/ei_signal_with_range.h"
 #include "edge-impulse-sdk/dsp/ei_flatten.h"
@@ -159,6 +163,393 @@ __attribute__((unused)) int extract_spectral_analysis_features(
     return EIDSP_NOT_SUPPORTED;
 }
 
+#if (EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1) && (EI_CLASSIFIER_QUANTIZATION_ENABLED == 1)
+/**
+ * Spectral analysis in fixed point, quantizes the features with the scale and zero point
+ * of the input tensor. Only for configs where spectral::feature_q15::is_supported holds.
+ * features_f32 (optional) receives the features before quantization.
+ */
+__attribute__((unused)) int extract_spectral_analysis_features_quantized(
+    signal_t *signal,
+    matrix_i8_t *output_matrix,
+    void *config_ptr,
+    float scale,
+    float zero_point,
+    const float frequency,
+    matrix_t *features_f32 = nullptr)
+{
+    ei_dsp_config_spectral_analysis_t *config = (ei_dsp_config_spectral_analysis_t *)config_ptr;
+
+    matrix_t input_matrix(signal->total_length / config->axes, config->axes);
+    if (!input_matrix.buffer) {
+        EIDSP_ERR(EIDSP_OUT_OF_MEM);
+    }
+
+    signal->get_data(0, signal->total_length, input_matrix.buffer);
+
+    size_t n_features = config->axes * (3 + config->fft_length / 2);
+    if (output_matrix->rows * output_matrix->cols != n_features ||
+        (features_f32 && features_f32->rows * features_f32->cols != n_features)) {
+        EIDSP_ERR(EIDSP_MATRIX_SIZE_MISMATCH);
+    }
+
+    return spectral::feature_q15::extract_spec_features_i8(
+        input_matrix.buffer,
+        input_matrix.rows,
+        input_matrix.cols,
+        config,
+        scale,
+        static_cast<int32_t>(zero_point),
+        output_matrix->buffer,
+        features_f32 ? features_f32->buffer : nullptr);
+}
+#endif // (EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1) && (EI_CLASSIFIER_QUANTIZATION_ENABLED == 1)
+
+#ifndef EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS
+#define EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS    4
+#endif // EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS
+
+/**
+ * State of the sliced spectral analysis of one DSP block. The last model window of scaled
+ * samples is kept in a ring, with running raw moment sums (x, x^2, x^3, x^4 per axis) over
+ * it. Power spectra of full FFT frames are kept by their position in the stream, so frames
+ * of one window that are also frames of the next one aren't transformed again.
+ */
+typedef struct {
+    const ei_dsp_config_spectral_analysis_t *config;
+    size_t axes;
+    size_t fft_length;
+    size_t hop;
+    size_t num_bins;
+    size_t window_size;         // samples per axis in a model window
+    float *window;              // [axes][window_size] ring of the scaled samples
+    size_t window_pos;          // ring position of the oldest sample
+    size_t stream_pos;          // samples per axis seen since the state was reset
+    float *shift;               // [axes] the moment sums are taken around this value
+    float *row_mean;            // [axes] mean of the window, removed before the FFT
+    double *moments;            // [axes][4] raw moment sums over the window
+    size_t resync_pos;          // stream position the sums are recomputed from the window at
+    float *frame_spectra;       // [max_frames][axes][num_bins] spectra of full frames
+    size_t *frame_start;        // [max_frames] stream position of each stored frame
+    size_t max_frames;
+    size_t frame_ix;            // next slot in the frame ring
+    size_t frame_count;
+    float *frame_buf;           // [fft_length]
+    float *fft_out;             // [fft_length / 2 + 1]
+} ei_dsp_spectral_slice_state_t;
+
+static ei_dsp_spectral_slice_state_t *ei_dsp_spectral_slice_states[EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS] = { nullptr };
+
+static void ei_dsp_spectral_slice_state_free(ei_dsp_spectral_slice_state_t *st) {
+    if (!st) {
+        return;
+    }
+    ei_free(st->window);
+    ei_free(st->shift);
+    ei_free(st->row_mean);
+    ei_free(st->moments);
+    ei_free(st->frame_spectra);
+    ei_free(st->frame_start);
+    ei_free(st->frame_buf);
+    ei_free(st->fft_out);
+    ei_free(st);
+}
+
+static void ei_dsp_spectral_slice_states_free() {
+    for (size_t ix = 0; ix < EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS; ix++) {
+        ei_dsp_spectral_slice_state_free(ei_dsp_spectral_slice_states[ix]);
+        ei_dsp_spectral_slice_states[ix] = nullptr;
+    }
+}
+
+/**
+ * State of the block with this config, created on first use
+ */
+static ei_dsp_spectral_slice_state_t *ei_dsp_spectral_slice_state_get(ei_dsp_config_spectral_analysis_t *config) {
+    size_t slot = EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS;
+    for (size_t ix = 0; ix < EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS; ix++) {
+        if (ei_dsp_spectral_slice_states[ix] && ei_dsp_spectral_slice_states[ix]->config == config) {
+            return ei_dsp_spectral_slice_states[ix];
+        }
+        if (!ei_dsp_spectral_slice_states[ix] && slot == EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS) {
+            slot = ix;
+        }
+    }
+    if (slot == EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS) {
+        ei_printf("ERR: Continuous spectral analysis supports up to %d blocks (EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS)\n",
+            EI_DSP_SPECTRAL_SLICE_MAX_BLOCKS);
+        return nullptr;
+    }
+
+    ei_dsp_spectral_slice_state_t *st =
+        (ei_dsp_spectral_slice_state_t *)ei_calloc(1, sizeof(ei_dsp_spectral_slice_state_t));
+    if (!st) {
+        return nullptr;
+    }
+
+    st->config = config;
+    st->axes = config->axes;
+    st->fft_length = config->fft_length;
+    st->hop = config->do_fft_overlap ? config->fft_length / 2 : config->fft_length;
+    st->num_bins = config->fft_length / 2;
+    st->window_size = EI_CLASSIFIER_RAW_SAMPLE_COUNT;
+    // frames that start inside one window
+    st->max_frames = (st->window_size + st->hop - 1) / st->hop;
+
+    st->window = (float *)ei_calloc(st->axes * st->window_size, sizeof(float));
+    st->shift = (float *)ei_calloc(st->axes, sizeof(float));
+    st->row_mean = (float *)ei_calloc(st->axes, sizeof(float));
+    st->moments = (double *)ei_calloc(st->axes * 4, sizeof(double));
+    st->frame_spectra = (float *)ei_calloc(st->max_frames * st->axes * st->num_bins, sizeof(float));
+    st->frame_start = (size_t *)ei_calloc(st->max_frames, sizeof(size_t));
+    st->frame_buf = (float *)ei_calloc(st->fft_length, sizeof(float));
+    st->fft_out = (float *)ei_calloc(st->fft_length / 2 + 1, sizeof(float));
+
+    if (!st->window || !st->shift || !st->row_mean || !st->moments || !st->frame_spectra ||
+        !st->frame_start || !st->frame_buf || !st->fft_out) {
+        ei_dsp_spectral_slice_state_free(st);
+        return nullptr;
+    }
+
+    ei_dsp_spectral_slice_states[slot] = st;
+    return st;
+}
+
+/**
+ * Scaled sample ix (0 is the oldest) of the window of an axis
+ */
+static inline float ei_dsp_spectral_slice_sample(const ei_dsp_spectral_slice_state_t *st, size_t axis, size_t ix) {
+    return st->window[axis * st->window_size + (st->window_pos + ix) % st->window_size];
+}
+
+/**
+ * Recompute the moment sums from the window, around its first sample like
+ * deinterleave_and_moments(), so rounding of the running sums doesn't build up
+ */
+static void ei_dsp_spectral_slice_resync(ei_dsp_spectral_slice_state_t *st, size_t stream_pos) {
+    for (size_t axis = 0; axis < st->axes; axis++) {
+        const float shift = ei_dsp_spectral_slice_sample(st, axis, 0);
+        double *sum = &st->moments[axis * 4];
+        memset(sum, 0, 4 * sizeof(double));
+        for (size_t ix = 0; ix < st->window_size; ix++) {
+            const double d = ei_dsp_spectral_slice_sample(st, axis, ix) - shift;
+            const double d2 = d * d;
+            sum[0] += d;
+            sum[1] += d2;
+            sum[2] += d2 * d;
+            sum[3] += d2 * d2;
+        }
+        st->shift[axis] = shift;
+    }
+    st->resync_pos = stream_pos + st->window_size;
+}
+
+/**
+ * Run the spectral analysis (FFT, implementation version 2 or 3, no filter) on one slice of
+ * a continuous stream. Once a full model window (EI_CLASSIFIER_RAW_SAMPLE_COUNT samples) has
+ * been seen, the features of the last window are written and reported in matrix_size_out.
+ * They are the features extract_spectral_analysis_features computes for that window, up to
+ * rounding: the moments come from running sums and the FFT frames sit on the hop grid from
+ * the start of the window, zero padded at its end like welch_max_hold() does.
+ *
+ * The moments cost is proportional to the slice. Full frames are only reused if the slice
+ * size is a multiple of the hop, otherwise every frame of the window is transformed again.
+ */
+__attribute__((unused)) int extract_spectral_analysis_per_slice_features(
+    signal_t *signal,
+    matrix_t *output_matrix,
+    void *config_ptr,
+    const float frequency,
+    matrix_size_t *matrix_size_out)
+{
+    ei_dsp_config_spectral_analysis_t *config = (ei_dsp_config_spectral_analysis_t *)config_ptr;
+
+    if (strcmp(config->analysis_type, "FFT") != 0 ||
+        (config->implementation_version != 2 && config->implementation_version != 3)) {
+        ei_printf("ERR: Continuous spectral analysis only supports FFT analysis (version 2 or 3)\n");
+        EIDSP_ERR(EIDSP_NOT_SUPPORTED);
+    }
+    if (strcmp(config->filter_type, "low") == 0 || strcmp(config->filter_type, "high") == 0) {
+        ei_printf("ERR: Continuous spectral analysis does not support filters\n");
+        EIDSP_ERR(EIDSP_NOT_SUPPORTED);
+    }
+
+    const size_t slice_size = signal->total_length / config->axes;
+    if (slice_size == 0 || slice_size > EI_CLASSIFIER_RAW_SAMPLE_COUNT || config->fft_length < 2) {
+        EIDSP_ERR(EIDSP_PARAMETER_INVALID);
+    }
+
+    ei_dsp_spectral_slice_state_t *st = ei_dsp_spectral_slice_state_get(config);
+    if (!st) {
+        EIDSP_ERR(EIDSP_OUT_OF_MEM);
+    }
+
+    const size_t axes = st->axes;
+    const size_t num_bins = st->num_bins;
+    const size_t window_size = st->window_size;
+    const size_t n_features = axes * (3 + num_bins);
+    if (output_matrix->rows * output_matrix->cols < n_features) {
+        EIDSP_ERR(EIDSP_MATRIX_SIZE_MISMATCH);
+    }
+
+    // raw (interleaved) samples of this slice
+    matrix_t input_matrix(slice_size, axes);
+    if (!input_matrix.buffer) {
+        EIDSP_ERR(EIDSP_OUT_OF_MEM);
+    }
+    EI_TRY(signal->get_data(0, slice_size * axes, input_matrix.buffer));
+
+    // push the slice into the window, once it's full the sums drop the samples that leave it
+    // (while it fills up they're computed when it's full)
+    for (size_t ix = 0; ix < slice_size; ix++) {
+        const float *sample = input_matrix.get_row_ptr(ix);
+        const bool window_full = st->stream_pos + ix >= window_size;
+        const size_t pos = window_full ? st->window_pos : st->stream_pos + ix;
+
+        for (size_t axis = 0; axis < axes; axis++) {
+            float *slot = &st->window[axis * window_size + pos];
+            const float x = sample[axis] * config->scale_axes;
+
+            if (window_full) {
+                double *sum = &st->moments[axis * 4];
+                const double d_out = *slot - st->shift[axis];
+                const double d_in = x - st->shift[axis];
+                const double d2_out = d_out * d_out;
+                const double d2_in = d_in * d_in;
+                sum[0] += d_in - d_out;
+                sum[1] += d2_in - d2_out;
+                sum[2] += d2_in * d_in - d2_out * d_out;
+                sum[3] += d2_in * d2_in - d2_out * d2_out;
+            }
+            *slot = x;
+        }
+        if (window_full) {
+            st->window_pos = (st->window_pos + 1) % window_size;
+        }
+        else if (st->stream_pos + ix + 1 == window_size) {
+            ei_dsp_spectral_slice_resync(st, window_size);
+        }
+    }
+    st->stream_pos += slice_size;
+
+    if (st->stream_pos < window_size) {
+        matrix_size_out->rows = 0;
+        matrix_size_out->cols = 0;
+        return EIDSP_OK;
+    }
+    // the sums also lose precision once the window moved away from the shift by more than
+    // its standard deviation, e.g. after a change of the offset
+    bool resync = st->stream_pos >= st->resync_pos;
+    for (size_t axis = 0; axis < axes && !resync; axis++) {
+        const double mean = st->moments[axis * 4] / window_size;
+        resync = 2 * mean * mean > st->moments[axis * 4 + 1] / window_size;
+    }
+    if (resync) {
+        ei_dsp_spectral_slice_resync(st, st->stream_pos);
+    }
+    const size_t window_start = st->stream_pos - window_size;
+    const size_t features_per_axis = 3 + num_bins;
+
+    float *features = output_matrix->buffer;
+    for (size_t axis = 0; axis < axes; axis++) {
+        const double *sum = &st->moments[axis * 4];
+        float *feature_out = &features[axis * features_per_axis];
+
+        // central moments of the window from its raw moments
+        const double mean = sum[0] / window_size;
+        const double e2 = sum[1] / window_size;
+        const double e3 = sum[2] / window_size;
+        const double e4 = sum[3] / window_size;
+        const double mean2 = mean * mean;
+        double m2 = e2 - mean2;
+        if (m2 < 0) {
+            m2 = 0;
+        }
+        const double m3 = e3 - 3 * mean * e2 + 2 * mean2 * mean;
+        const double m4 = e4 - 4 * mean * e3 + 6 * mean2 * e2 - 3 * mean2 * mean2;
+
+        float stddev = (float)sqrt(m2);
+        feature_out[0] = stddev;
+        if (stddev == 0.0f) {
+            stddev = 1e-10f;
+        }
+        const float temp = stddev * stddev * stddev;
+        feature_out[1] = (float)m3 / temp;
+        feature_out[2] = ((float)m4 / (temp * stddev)) - 3;
+
+        st->row_mean[axis] = st->shift[axis] + (float)mean;
+        memset(&feature_out[3], 0, num_bins * sizeof(float));
+    }
+
+    // max hold over the frames from the start of the window, with its mean removed
+    for (size_t frame = 0; frame < window_size; frame += st->hop) {
+        const size_t frame_points = std::min(st->fft_length, window_size - frame);
+        const bool full_frame = frame_points == st->fft_length;
+
+        // a constant only changes bin 0, which isn't a feature, so the spectra of full frames
+        // can be shared between windows with a different mean
+        size_t slot = st->max_frames;
+        if (full_frame) {
+            for (size_t ix = 0; ix < st->frame_count; ix++) {
+                if (st->frame_start[ix] == window_start + frame) {
+                    slot = ix;
+                    break;
+                }
+            }
+        }
+        const bool cached = slot != st->max_frames;
+        if (full_frame && !cached) {
+            slot = st->frame_ix;
+            st->frame_start[slot] = window_start + frame;
+            st->frame_ix = (st->frame_ix + 1) % st->max_frames;
+            if (st->frame_count < st->max_frames) {
+                st->frame_count++;
+            }
+        }
+
+        for (size_t axis = 0; axis < axes; axis++) {
+            const float *spectrum;
+            if (cached) {
+                spectrum = &st->frame_spectra[(slot * axes + axis) * num_bins];
+            }
+            else {
+                for (size_t ix = 0; ix < frame_points; ix++) {
+                    st->frame_buf[ix] = ei_dsp_spectral_slice_sample(st, axis, frame + ix) - st->row_mean[axis];
+                }
+                EI_TRY(numpy::power_spectrum(
+                    st->frame_buf,
+                    frame_points,
+                    st->fft_out,
+                    st->fft_length / 2 + 1,
+                    st->fft_length));
+                spectrum = &st->fft_out[1];
+                if (full_frame) {
+                    memcpy(&st->frame_spectra[(slot * axes + axis) * num_bins], spectrum, num_bins * sizeof(float));
+                }
+            }
+
+            float *feature_out = &features[axis * features_per_axis + 3];
+            for (size_t bin = 0; bin < num_bins; bin++) {
+                feature_out[bin] = std::max(feature_out[bin], spectrum[bin]);
+            }
+        }
+    }
+
+    if (config->do_log) {
+        for (size_t axis = 0; axis < axes; axis++) {
+            float *feature_out = &features[axis * features_per_axis + 3];
+            numpy::zero_handling(feature_out, num_bins);
+            ei_matrix temp_matrix(num_bins, 1, feature_out);
+            numpy::log10(&temp_matrix);
+        }
+    }
+
+    matrix_size_out->rows = 1;
+    matrix_size_out->cols = n_features;
+
+    return EIDSP_OK;
+}
+
 __attribute__((unused)) int extract_raw_features(signal_t *signal, matrix_t *output_matrix, void *config_ptr, const float frequency) {
     ei_dsp_config_raw_t config = *((ei_dsp_config_raw_t*)config_ptr);
 
@@ -1383,6 +1774,8 @@ __attribute__((unused)) int ei_dsp_clear_continuous_audio_state() {
     ei_dsp_cont_current_frame_size = 0;
     ei_dsp_cont_current_frame_ix = 0;
 
+    ei_dsp_spectral_slice_states_free();
+
     return EIDSP_OK;
 }
 
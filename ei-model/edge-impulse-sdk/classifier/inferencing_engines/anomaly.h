@@ -42,10 +42,19 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdint.h>
-
+#include <string.h>
+#include <cfloat>
+#include <algorithm>
+
+#include "edge-impulse-sdk/dsp/config.hpp"
+#if EIDSP_USE_CMSIS_DSP
+#include "edge-impulse-sdk/CMSIS/DSP/Include/dsp/basic_math_functions.h"
+#include "edge-impulse-sdk/CMSIS/DSP/Include/dsp/statistics_functions.h"
+#endif // EIDSP_USE_CMSIS_DSP
 #include "edge-impulse-sdk/classifier/ei_classifier_types.h"
 #include "edge-impulse-sdk/classifier/ei_aligned_malloc.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include "edge-impulse-sdk/classifier/inferencing_engines/engines.h"
 #include "edge-impulse-sdk/classifier/ei_fill_result_struct.h"
 
@@ -67,6 +76,113 @@ void standard_scaler(float *input, const float *scale, const float *mean, size_t
     }
 }
 
+/**
+ * Centroids of a k-means anomaly block, packed from ei_classifier_anom_cluster_t into one
+ * contiguous centroid matrix (one row per cluster) and a separate array of max errors
+ */
+typedef struct {
+    const ei_classifier_anom_cluster_t *source;
+    size_t cluster_count;
+    size_t axes_size;
+    float *centroids;       // [cluster_count][axes_size]
+    float *max_error;       // [cluster_count]
+    size_t last_best;       // cluster that scored best last time, tried first
+} ei_anomaly_packed_clusters_t;
+
+static ei_anomaly_packed_clusters_t ei_anomaly_packed_clusters = {};
+
+/**
+ * Get the packed centroids for a cluster array, (re)building them when the array changes
+ * @returns the packed clusters, or nullptr when out of memory
+ */
+static ei_anomaly_packed_clusters_t *get_packed_clusters(const ei_classifier_anom_cluster_t *clusters, size_t cluster_size, size_t input_size) {
+    ei_anomaly_packed_clusters_t *packed = &ei_anomaly_packed_clusters;
+
+    if (packed->source == clusters && packed->cluster_count == cluster_size && packed->axes_size == input_size) {
+        return packed;
+    }
+
+    if (packed->centroids) {
+        ei_free(packed->centroids);
+    }
+    memset(packed, 0, sizeof(ei_anomaly_packed_clusters_t));
+
+    // one allocation for the centroid matrix followed by the max errors
+    float *buffer = (float *)ei_malloc((cluster_size * input_size + cluster_size) * sizeof(float));
+    if (!buffer) {
+        return nullptr;
+    }
+
+    packed->centroids = buffer;
+    packed->max_error = buffer + (cluster_size * input_size);
+    for (size_t cluster = 0; cluster < cluster_size; cluster++) {
+        memcpy(&packed->centroids[cluster * input_size], clusters[cluster].centroid, input_size * sizeof(float));
+        packed->max_error[cluster] = clusters[cluster].max_error;
+    }
+    packed->source = clusters;
+    packed->cluster_count = cluster_size;
+    packed->axes_size = input_size;
+
+    return packed;
+}
+
+/**
+ * Release the packed centroids, they're packed again on the next anomaly score
+ */
+static void free_packed_clusters(void) {
+    ei_anomaly_packed_clusters_t *packed = &ei_anomaly_packed_clusters;
+
+    if (packed->centroids) {
+        ei_free(packed->centroids);
+    }
+    memset(packed, 0, sizeof(ei_anomaly_packed_clusters_t));
+}
+
+/**
+ * Squared euclidean distance between input and centroid, giving up as soon as the
+ * partial sum exceeds bound
+ * @param input Array of input values (already scaled by standard_scaler)
+ * @param centroid Centroid of the same size as input
+ * @param input_size Size of the input array
+ * @param bound Stop once the distance is known to be larger than this
+ * @returns the squared distance, or a partial sum larger than bound
+ */
+static inline float calculate_squared_distance_bounded(const float *input, const float *centroid, size_t input_size, float bound) {
+    float dist = 0.0f;
+    size_t ix = 0;
+
+#if EIDSP_USE_CMSIS_DSP
+    float diff[16];
+    for (; ix < input_size; ix += 16) {
+        uint32_t block_size = (uint32_t)std::min<size_t>(16, input_size - ix);
+        float block_dist;
+        arm_sub_f32(input + ix, centroid + ix, diff, block_size);
+        arm_power_f32(diff, block_size, &block_dist);
+        dist += block_dist;
+        if (dist > bound) {
+            return dist;
+        }
+    }
+#else
+    for (; ix + 4 <= input_size; ix += 4) {
+        const float d0 = input[ix] - centroid[ix];
+        const float d1 = input[ix + 1] - centroid[ix + 1];
+        const float d2 = input[ix + 2] - centroid[ix + 2];
+        const float d3 = input[ix + 3] - centroid[ix + 3];
+        dist += (d0 * d0 + d1 * d1) + (d2 * d2 + d3 * d3);
+        if (dist > bound) {
+            return dist;
+        }
+    }
+    for (; ix < input_size; ix++) {
+        const float d = input[ix] - centroid[ix];
+        dist += d * d;
+    }
+#endif // EIDSP_USE_CMSIS_DSP
+
+    return dist;
+}
+
 /**
  * Calculate the distance between input vector and the cluster
  * @param input Array of input values (already scaled by standard_scaler)
@@ -76,15 +192,15 @@ void standard_scaler(float *input, const float *scale, const float *mean, size_t
 float calculate_cluster_distance(float *input, size_t input_size, const ei_classifier_anom_cluster_t *cluster) {
     // todo: check input_size and centroid size?
 
-    float dist = 0.0f;
-    for (size_t ix = 0; ix < input_size; ix++) {
-        dist += pow(input[ix] - cluster->centroid[ix], 2);
-    }
-    return sqrt(dist) - cluster->max_error;
+    float dist = calculate_squared_distance_bounded(input, cluster->centroid, input_size, FLT_MAX);
+    return sqrtf(dist) - cluster->max_error;
 }
 
 /**
  * Get minimum distance to a cluster
+ * Works on squared distances and drops a cluster as soon as its partial distance can no longer
+ * beat the best score so far. The cluster that scored best on the previous call is tried first,
+ * as consecutive windows tend to land near the same cluster.
  * @param input Array of input values (already scaled by standard_scaler)
  * @param input_size Size of the input array
  * @param clusters Array of clusters
@@ -92,10 +208,35 @@ float calculate_cluster_distance(float *input, size_t input_size, const ei_class
  */
 float get_min_distance_to_cluster(float *input, size_t input_size, const ei_classifier_anom_cluster_t *clusters, size_t cluster_size) {
     float min = 1000.0f;
-    for (size_t ix = 0; ix < cluster_size; ix++) {
-        float dist = calculate_cluster_distance(input, input_size, &clusters[ix]);
-        if (dist < min) {
-            min = dist;
+
+    ei_anomaly_packed_clusters_t *packed = get_packed_clusters(clusters, cluster_size, input_size);
+    if (!packed) {
+        // out of memory, score straight from the cluster array
+        for (size_t ix = 0; ix < cluster_size; ix++) {
+            float dist = calculate_cluster_distance(input, input_size, &clusters[ix]);
+            if (dist < min) {
+                min = dist;
+            }
+        }
+        return min;
+    }
+
+    const size_t first = packed->last_best < cluster_size ? packed->last_best : 0;
+    for (size_t n = 0; n < cluster_size; n++) {
+        const size_t ix = n == 0 ? first : (n <= first ? n - 1 : n);
+        const float max_error = packed->max_error[ix];
+
+        // sqrt(dist) - max_error < min  <=>  dist < (min + max_error)^2
+        const float limit = min + max_error;
+        if (limit <= 0.0f) {
+            continue;
+        }
+        const float bound = limit * limit;
+
+        float dist = calculate_squared_distance_bounded(input, &packed->centroids[ix * input_size], input_size, bound);
+        if (dist < bound) {
+            min = sqrtf(dist) - max_error;
+            packed->last_best = ix;
         }
     }
     return min;
@@ -178,6 +319,8 @@ EI_IMPULSE_ERROR run_kmeans_anomaly(
     void *config_ptr,
     bool debug = false)
 {
+    EI_TRACE_ZONE("anomaly");
+
     ei_learning_block_config_anomaly_kmeans_t *block_config = (ei_learning_block_config_anomaly_kmeans_t*)config_ptr;
 
     uint64_t anomaly_start_us = ei_read_timer_us();
@@ -221,6 +364,8 @@ EI_IMPULSE_ERROR run_gmm_anomaly(
     void *config_ptr,
     bool debug = false)
 {
+    EI_TRACE_ZONE("anomaly");
+
     ei_learning_block_config_anomaly_gmm_t *block_config = (ei_learning_block_config_anomaly_gmm_t*)config_ptr;
 
     ei_learning_block_config_tflite_graph_t ei_learning_block_config_gmm = {
@@ -44,6 +44,73 @@
 #include "edge-impulse-sdk/classifier/ei_model_types.h"
 #include "edge-impulse-sdk/classifier/inferencing_engines/tflite_helper.h"
 #include "edge-impulse-sdk/classifier/ei_run_dsp.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
+
+#if EI_CLASSIFIER_TFLITE_EON_PERSISTENT == 1
+#ifndef EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS
+#define EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS  4
+#endif
+
+// Graphs kept initialized between inferences. They are identified by the reset function,
+// as graph config may be a temporary (e.g. in extract_tflite_eon_features)
+static TfLiteStatus (*tflite_eon_persistent_graphs[EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS])(void (*free)(void* ptr));
+#endif // EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+
+/**
+ * Initialize the graph, in persistent mode only if it's not initialized yet
+ */
+static TfLiteStatus tflite_eon_graph_init(ei_config_tflite_eon_graph_t *graph_config) {
+#if EI_CLASSIFIER_TFLITE_EON_PERSISTENT == 1
+    size_t free_ix = EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS;
+
+    for (size_t ix = 0; ix < EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS; ix++) {
+        if (tflite_eon_persistent_graphs[ix] == graph_config->model_reset) {
+            return kTfLiteOk;
+        }
+        if (tflite_eon_persistent_graphs[ix] == nullptr && free_ix == EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS) {
+            free_ix = ix;
+        }
+    }
+
+    TfLiteStatus status = graph_config->model_init(ei_aligned_calloc);
+    // no free slot, graph is released after the inference as usual
+    if (status == kTfLiteOk && free_ix < EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS) {
+        tflite_eon_persistent_graphs[free_ix] = graph_config->model_reset;
+    }
+    return status;
+#else
+    return graph_config->model_init(ei_aligned_calloc);
+#endif // EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+}
+
+/**
+ * Release the graph after inference, persistent graphs are kept
+ */
+static TfLiteStatus tflite_eon_graph_release(ei_config_tflite_eon_graph_t *graph_config) {
+#if EI_CLASSIFIER_TFLITE_EON_PERSISTENT == 1
+    for (size_t ix = 0; ix < EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS; ix++) {
+        if (tflite_eon_persistent_graphs[ix] == graph_config->model_reset) {
+            return kTfLiteOk;
+        }
+    }
+#endif // EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+    return graph_config->model_reset(ei_aligned_free);
+}
+
+/**
+ * Release all persistent graphs, called from run_classifier_deinit()
+ */
+__attribute__((unused)) static void tflite_eon_deinit(void) {
+#if EI_CLASSIFIER_TFLITE_EON_PERSISTENT == 1
+    for (size_t ix = 0; ix < EI_CLASSIFIER_TFLITE_EON_MAX_PERSISTENT_GRAPHS; ix++) {
+        if (tflite_eon_persistent_graphs[ix] != nullptr) {
+            tflite_eon_persistent_graphs[ix](ei_aligned_free);
+            tflite_eon_persistent_graphs[ix] = nullptr;
+        }
+    }
+#endif // EI_CLASSIFIER_TFLITE_EON_PERSISTENT
+}
 
 /**
  * Setup the TFLite runtime
@@ -68,7 +135,7 @@ static EI_IMPULSE_ERROR inference_tflite_setup(
 
     *ctx_start_us = ei_read_timer_us();
 
-    TfLiteStatus init_status = graph_config->model_init(ei_aligned_calloc);
+    TfLiteStatus init_status = tflite_eon_graph_init(graph_config);
     if (init_status != kTfLiteOk) {
         ei_printf("Failed to initialize the model (error code %d)\n", init_status);
         return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
@@ -124,8 +191,11 @@ static EI_IMPULSE_ERROR inference_tflite_run(
 
     ei_config_tflite_eon_graph_t *graph_config = (ei_config_tflite_eon_graph_t*)block_config->graph_config;
 
-    if (graph_config->model_invoke() != kTfLiteOk) {
-        return EI_IMPULSE_TFLITE_ERROR;
+    {
+        EI_TRACE_ZONE("eon_invoke");
+        if (graph_config->model_invoke() != kTfLiteOk) {
+            return EI_IMPULSE_TFLITE_ERROR;
+        }
     }
 
     uint64_t ctx_end_us = ei_read_timer_us();
@@ -202,7 +272,7 @@ EI_IMPULSE_ERROR run_nn_inference_from_dsp(
         return output_res;
     }
 
-    if (graph_config->model_reset(ei_aligned_free) != kTfLiteOk) {
+    if (tflite_eon_graph_release(graph_config) != kTfLiteOk) {
         return EI_IMPULSE_TFLITE_ERROR;
     }
 
@@ -276,7 +346,7 @@ EI_IMPULSE_ERROR run_nn_inference(
         }
     }
 
-    graph_config->model_reset(ei_aligned_free);
+    tflite_eon_graph_release(graph_config);
 
     if (run_res != EI_IMPULSE_OK) {
         return run_res;
@@ -370,7 +440,108 @@ EI_IMPULSE_ERROR run_nn_inference_image_quantized(
         result,
         debug);
 
-    graph_config->model_reset(ei_aligned_free);
+    tflite_eon_graph_release(graph_config);
+
+    if (run_res != EI_IMPULSE_OK) {
+        return run_res;
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1
+/**
+ * Run the (single) spectral analysis block in fixed point, writing the quantized features
+ * straight into the input tensor, then the neural network. Only works if
+ * 'can_run_classifier_spectral_quantized' returns EI_IMPULSE_OK.
+ *
+ * @param      features  Float copy of the features for the other learning blocks (can be nullptr)
+ */
+EI_IMPULSE_ERROR run_nn_inference_spectral_quantized(
+    const ei_impulse_t *impulse,
+    signal_t *signal,
+    ei_impulse_result_t *result,
+    void *config_ptr,
+    ei::matrix_t *features,
+    bool debug = false) {
+
+    ei_learning_block_config_tflite_graph_t *block_config = (ei_learning_block_config_tflite_graph_t*)config_ptr;
+    ei_config_tflite_eon_graph_t *graph_config = (ei_config_tflite_eon_graph_t*)block_config->graph_config;
+
+    uint64_t ctx_start_us;
+    TfLiteTensor input;
+    TfLiteTensor output;
+    TfLiteTensor output_scores;
+    TfLiteTensor output_labels;
+
+    ei_unique_ptr_t p_tensor_arena(nullptr, ei_aligned_free);
+
+    EI_IMPULSE_ERROR init_res = inference_tflite_setup(
+        block_config,
+        &ctx_start_us,
+        &input, &output,
+        &output_labels,
+        &output_scores,
+        p_tensor_arena);
+
+    if (init_res != EI_IMPULSE_OK) {
+        return init_res;
+    }
+
+    if (input.type != TfLiteType::kTfLiteInt8) {
+        tflite_eon_graph_release(graph_config);
+        return EI_IMPULSE_INPUT_TENSOR_WAS_NULL;
+    }
+
+    uint64_t dsp_start_us = ei_read_timer_us();
+
+    // features matrix maps around the input tensor to not allocate any memory
+    ei::matrix_i8_t features_matrix(1, impulse->nn_input_frame_size, input.data.int8);
+
+    int ret;
+    {
+        EI_TRACE_ZONE("dsp");
+        ret = extract_spectral_analysis_features_quantized(signal, &features_matrix, impulse->dsp_blocks[0].config,
+            input.params.scale, input.params.zero_point, impulse->frequency, features);
+    }
+
+    if (ret != EIDSP_OK) {
+        ei_printf("ERR: Failed to run DSP process (%d)\n", ret);
+        tflite_eon_graph_release(graph_config);
+        return EI_IMPULSE_DSP_ERROR;
+    }
+
+    if (ei_run_impulse_check_canceled() == EI_IMPULSE_CANCELED) {
+        tflite_eon_graph_release(graph_config);
+        return EI_IMPULSE_CANCELED;
+    }
+
+    result->timing.dsp_us = ei_read_timer_us() - dsp_start_us;
+    result->timing.dsp = (int)(result->timing.dsp_us / 1000);
+
+    if (debug) {
+        ei_printf("Features (%d ms.): ", result->timing.dsp);
+        for (size_t ix = 0; ix < features_matrix.cols; ix++) {
+            ei_printf_float((features_matrix.buffer[ix] - input.params.zero_point) * input.params.scale);
+            ei_printf(" ");
+        }
+        ei_printf("\n");
+    }
+
+    ctx_start_us = ei_read_timer_us();
+
+    EI_IMPULSE_ERROR run_res = inference_tflite_run(
+        impulse,
+        block_config,
+        ctx_start_us,
+        &output,
+        &output_labels,
+        &output_scores,
+        static_cast<uint8_t*>(p_tensor_arena.get()),
+        result,
+        debug);
+
+    tflite_eon_graph_release(graph_config);
 
     if (run_res != EI_IMPULSE_OK) {
         return run_res;
@@ -378,6 +549,7 @@ EI_IMPULSE_ERROR run_nn_inference_image_quantized(
 
     return EI_IMPULSE_OK;
 }
+#endif // EI_CLASSIFIER_SPECTRAL_QUANTIZED == 1
 #endif // EI_CLASSIFIER_QUANTIZATION_ENABLED == 1
 
 __attribute__((unused)) int extract_tflite_eon_features(signal_t *signal, matrix_t *output_matrix, void *config_ptr, const float frequency) {
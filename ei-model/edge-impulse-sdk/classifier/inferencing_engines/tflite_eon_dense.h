@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+#ifndef _EI_CLASSIFIER_INFERENCING_ENGINE_TFLITE_EON_DENSE_H_
+#define _EI_CLASSIFIER_INFERENCING_ENGINE_TFLITE_EON_DENSE_H_
+
+#include <stdint.h>
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#if EI_CLASSIFIER_TFLITE_ENABLE_CMSIS_NN == 1
+#include "edge-impulse-sdk/CMSIS/NN/Include/arm_nnsupportfunctions.h"
+#else
+#include "edge-impulse-sdk/tensorflow/lite/kernels/internal/common.h"
+#endif
+
+namespace ei {
+namespace eon_dense {
+
+/**
+ * Requantize an accumulator, with the same rounding as the FULLY_CONNECTED kernel
+ * the interpreter would run (CMSIS-NN or reference)
+ */
+static inline int32_t requantize(int32_t acc, int32_t multiplier, int shift)
+{
+#if EI_CLASSIFIER_TFLITE_ENABLE_CMSIS_NN == 1
+    return arm_nn_requantize(acc, multiplier, shift);
+#else
+    return tflite::MultiplyByQuantizedMultiplier(acc, multiplier, shift);
+#endif
+}
+
+/**
+ * int8 FULLY_CONNECTED layer (per tensor quantization, weights zero point 0) with the shape,
+ * offsets, requantization and fused activation fixed at compile time, so the compiler can
+ * unroll and schedule it without tensor lookups or op dispatch.
+ *
+ * @tparam InputSize     Number of inputs (weights are OutputSize x InputSize, row major)
+ * @tparam OutputSize    Number of outputs
+ * @tparam InputOffset   Negated zero point of the input
+ * @tparam OutputOffset  Zero point of the output
+ * @tparam Multiplier    Quantized multiplier of input_scale * weights_scale / output_scale
+ * @tparam Shift         Shift of the multiplier
+ * @tparam ActMin        Lower bound of the fused activation (quantized)
+ * @tparam ActMax        Upper bound of the fused activation (quantized)
+ */
+template <int InputSize, int OutputSize, int32_t InputOffset, int32_t OutputOffset,
+          int32_t Multiplier, int Shift, int32_t ActMin, int32_t ActMax>
+struct fully_connected_s8 {
+    static_assert(InputSize > 0 && OutputSize > 0, "Empty layer");
+    static_assert(ActMin >= -128 && ActMax <= 127 && ActMin <= ActMax, "Invalid activation range");
+
+    static void invoke(const int8_t *input, const int8_t *weights, const int32_t *bias, int8_t *output)
+    {
+        for (int out = 0; out < OutputSize; out++) {
+            const int8_t *row = weights + out * InputSize;
+
+            int32_t acc = 0;
+            for (int ix = 0; ix < InputSize; ix++) {
+                acc += (static_cast<int32_t>(input[ix]) + InputOffset) * row[ix];
+            }
+            if (bias) {
+                acc += bias[out];
+            }
+
+            acc = requantize(acc, Multiplier, Shift) + OutputOffset;
+            acc = acc < ActMin ? ActMin : (acc > ActMax ? ActMax : acc);
+            output[out] = static_cast<int8_t>(acc);
+        }
+    }
+};
+
+} // namespace eon_dense
+} // namespace ei
+
+#endif // _EI_CLASSIFIER_INFERENCING_ENGINE_TFLITE_EON_DENSE_H_
@@ -102,5 +102,11 @@
 #define EIDSP_SIGNAL_C_FN_POINTER    0
 #endif // EIDSP_SIGNAL_C_FN_POINTER
 
+// number of FFT lengths for which the real FFT plan and scratch buffers are kept
+// between calls, set to 0 to allocate them on every FFT
+#ifndef EIDSP_FFT_PLAN_CACHE_SIZE
+#define EIDSP_FFT_PLAN_CACHE_SIZE    4
+#endif // EIDSP_FFT_PLAN_CACHE_SIZE
+
 // clang-format on
 #endif // _EIDSP_CPP_CONFIG_H_
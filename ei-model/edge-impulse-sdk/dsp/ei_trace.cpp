@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+#include "ei_trace.h"
+
+#if EI_TRACE_ENABLED
+
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+static_assert((EI_TRACE_RING_SIZE & (EI_TRACE_RING_SIZE - 1)) == 0,
+              "EI_TRACE_RING_SIZE has to be a power of two");
+
+static ei_trace_event_t trace_ring[EI_TRACE_RING_SIZE];
+static uint32_t trace_head = 0;
+static bool trace_enabled = true;
+
+__attribute__((weak)) void ei_trace_port_init(void)
+{
+}
+
+__attribute__((weak)) uint32_t ei_trace_read_cycles(void)
+{
+    return (uint32_t)ei_read_timer_us();
+}
+
+__attribute__((weak)) uint64_t ei_trace_cycles_to_ns(uint64_t cycles)
+{
+    return cycles * 1000;
+}
+
+__attribute__((weak)) uint32_t ei_trace_thread_id(void)
+{
+    return 0;
+}
+
+void ei_trace_init(void)
+{
+    ei_trace_port_init();
+    ei_trace_reset();
+}
+
+void ei_trace_reset(void)
+{
+    for (size_t ix = 0; ix < EI_TRACE_RING_SIZE; ix++) {
+        __atomic_store_n(&trace_ring[ix].seq, 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&trace_head, 0, __ATOMIC_RELEASE);
+}
+
+bool ei_trace_set_enabled(bool enabled)
+{
+    return __atomic_exchange_n(&trace_enabled, enabled, __ATOMIC_ACQ_REL);
+}
+
+void ei_trace_record(const char *name, uint32_t start, uint32_t end)
+{
+    if (!__atomic_load_n(&trace_enabled, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    // claim a slot, then publish it through seq once all fields are written
+    uint32_t index = __atomic_fetch_add(&trace_head, 1, __ATOMIC_RELAXED);
+    ei_trace_event_t *event = &trace_ring[index & (EI_TRACE_RING_SIZE - 1)];
+
+    __atomic_store_n(&event->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    event->name = name;
+    event->start = start;
+    event->duration = end - start;
+    event->thread_id = ei_trace_thread_id();
+    __atomic_store_n(&event->seq, index + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t ei_trace_event_count(void)
+{
+    return __atomic_load_n(&trace_head, __ATOMIC_ACQUIRE);
+}
+
+bool ei_trace_get_event(uint32_t index, ei_trace_event_t *event)
+{
+    const ei_trace_event_t *slot = &trace_ring[index & (EI_TRACE_RING_SIZE - 1)];
+
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != index + 1) {
+        return false;
+    }
+    event->name = slot->name;
+    event->start = slot->start;
+    event->duration = slot->duration;
+    event->thread_id = slot->thread_id;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    // a writer may have taken the slot over while we were copying it
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != index + 1) {
+        return false;
+    }
+    event->seq = index + 1;
+
+    return true;
+}
+
+#endif // EI_TRACE_ENABLED
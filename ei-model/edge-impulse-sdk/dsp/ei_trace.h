@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+#ifndef __EITRACE__H__
+#define __EITRACE__H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Scoped zone tracer. Every EI_TRACE_ZONE records its name, start time and
+ * duration into a fixed-size ring, timed by the cycle counter of the target
+ * (through the porting layer). The ring is written lock-free from any thread,
+ * the oldest events are overwritten when it wraps.
+ *
+ * Compiled out unless EI_TRACE_ENABLED is set to 1.
+ */
+#ifndef EI_TRACE_ENABLED
+#define EI_TRACE_ENABLED 0
+#endif
+
+// Number of events kept in the ring, has to be a power of two
+#ifndef EI_TRACE_RING_SIZE
+#define EI_TRACE_RING_SIZE 512
+#endif
+
+#if EI_TRACE_ENABLED
+
+typedef struct {
+    const char *name;   // static string, only the pointer is stored
+    uint32_t start;     // cycle counter at zone entry
+    uint32_t duration;  // cycles spent in the zone
+    uint32_t thread_id;
+    uint32_t seq;       // index of the event + 1 once the event is complete
+} ei_trace_event_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Porting functions, weak defaults use ei_read_timer_us (1 cycle = 1 us) and
+ * a single thread.
+ */
+void ei_trace_port_init(void);
+uint32_t ei_trace_read_cycles(void);
+uint64_t ei_trace_cycles_to_ns(uint64_t cycles);
+uint32_t ei_trace_thread_id(void);
+
+void ei_trace_init(void);
+void ei_trace_reset(void);
+void ei_trace_record(const char *name, uint32_t start, uint32_t end);
+
+/**
+ * @brief      Pause or resume recording, zones are dropped while paused
+ *
+ * @return     Previous state
+ */
+bool ei_trace_set_enabled(bool enabled);
+
+/**
+ * @brief      Number of events recorded since the last reset. Events
+ *             [max(0, count - EI_TRACE_RING_SIZE), count) are in the ring.
+ */
+uint32_t ei_trace_event_count(void);
+
+/**
+ * @brief      Copy an event out of the ring
+ *
+ * @param[in]  index  Event index, see ei_trace_event_count
+ * @param      event  Output event
+ *
+ * @return     false if the event was overwritten or is still being written
+ */
+bool ei_trace_get_event(uint32_t index, ei_trace_event_t *event);
+
+#ifdef __cplusplus
+}
+
+class EiTraceZone {
+public:
+    EiTraceZone(const char *name) : name(name), start(ei_trace_read_cycles())
+    {
+    }
+    ~EiTraceZone()
+    {
+        ei_trace_record(name, start, ei_trace_read_cycles());
+    }
+
+private:
+    const char *name;
+    uint32_t start;
+};
+
+#define EI_TRACE_CONCAT_(a, b) a##b
+#define EI_TRACE_CONCAT(a, b) EI_TRACE_CONCAT_(a, b)
+#define EI_TRACE_ZONE(name) EiTraceZone EI_TRACE_CONCAT(ei_trace_zone_, __LINE__)(name)
+#endif // __cplusplus
+
+#else
+
+#define EI_TRACE_ZONE(name) do { } while (0)
+
+#endif // EI_TRACE_ENABLED
+
+#endif  //!__EITRACE__H__
@@ -34,6 +34,7 @@
 // clang-format off
 #include <functional>
 #include <stdio.h>
+#include <string.h>
 #include <memory>
 #include "../porting/ei_classifier_porting.h"
 #include "edge-impulse-sdk/classifier/ei_aligned_malloc.h"
@@ -243,6 +244,164 @@ static ei_unique_ptr_t make_tracked_unique_ptr(void* ptr_in, size_t size)
  */
 #define EI_MAKE_TRACKED_POINTER(ptr, size) ei::make_tracked_unique_ptr(&ptr, sizeof(*ptr)*size);
 
+/**
+ * Bump allocator for the scratch memory of one impulse run. Allocations are never freed
+ * individually, the whole arena is reset at the start of the next run. While an arena is
+ * active (see ei_arena_scope_t) matrix_t buffers are taken from it, and fall back to the
+ * heap once it is exhausted.
+ */
+class ei_arena_t {
+public:
+    ei_arena_t() : buffer(nullptr), size(0), used(0), peak(0), demand(0), heap_fallback_bytes(0) { }
+
+    ~ei_arena_t() {
+        release();
+    }
+
+    /**
+     * Allocate the backing buffer
+     * @param arena_size Size in bytes
+     * @returns true if OK
+     */
+    bool init(size_t arena_size) {
+        release();
+        buffer = (uint8_t *)ei_malloc(arena_size);
+        if (!buffer) {
+            return false;
+        }
+        size = arena_size;
+        return true;
+    }
+
+    /**
+     * Free the backing buffer. Call it from the thread that runs the impulse, between runs
+     * (run_classifier_deinit() on the inference thread). While the arena is active a run is
+     * using it, so nothing is freed then.
+     */
+    void release() {
+        if (active() == this) {
+            return;
+        }
+        if (buffer) {
+            ei_free(buffer);
+        }
+        buffer = nullptr;
+        size = 0;
+        used = 0;
+    }
+
+    void reset() {
+        used = 0;
+        demand = 0;
+    }
+
+    bool is_initialized() const {
+        return buffer != nullptr;
+    }
+
+    /**
+     * Allocate zeroed memory from the arena
+     * @param bytes Size in bytes
+     * @returns pointer, or nullptr if the arena can't hold it (nothing is taken in that case)
+     */
+    void *calloc(size_t bytes) {
+        const size_t aligned = aligned_size(bytes);
+        demand += aligned;
+        if (demand > peak) {
+            peak = demand;
+        }
+        if (!buffer || used + aligned > size) {
+            heap_fallback_bytes += bytes;
+            return nullptr;
+        }
+        void *ptr = buffer + used;
+        used += aligned;
+        memset(ptr, 0, bytes);
+        return ptr;
+    }
+
+    size_t available() const {
+        return size - used;
+    }
+
+    size_t get_size() const {
+        return size;
+    }
+
+    size_t get_used() const {
+        return used;
+    }
+
+    /**
+     * Largest number of bytes requested from the arena in a single run, including requests
+     * that did not fit. Use this to size the arena.
+     */
+    size_t get_peak() const {
+        return peak;
+    }
+
+    /**
+     * Bytes that went to the heap because the arena was full, since the arena was created
+     */
+    size_t get_heap_fallback_bytes() const {
+        return heap_fallback_bytes;
+    }
+
+    /**
+     * The arena that scratch allocations currently come from, if any. This is one pointer
+     * for the whole process and it isn't locked: impulses that use arenas must run on a
+     * single thread, one at a time.
+     */
+    static ei_arena_t *&active() {
+        static ei_arena_t *active_arena = nullptr;
+        return active_arena;
+    }
+
+    /**
+     * Allocate zeroed scratch memory from the active arena
+     * @returns pointer, or nullptr if no arena is active or it is full
+     */
+    static void *scratch_calloc(size_t bytes) {
+        ei_arena_t *arena = active();
+        return arena ? arena->calloc(bytes) : nullptr;
+    }
+
+    static constexpr size_t alignment = 8;
+
+    /**
+     * Bytes that calloc takes from the arena for a request of this size
+     */
+    static constexpr size_t aligned_size(size_t bytes) {
+        return (bytes + (alignment - 1)) & ~(alignment - 1);
+    }
+
+private:
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+    size_t peak;
+    size_t demand;
+    size_t heap_fallback_bytes;
+};
+
+/**
+ * Makes an arena the active one for the lifetime of the scope, pass nullptr to suspend
+ * arena allocations (e.g. while creating state that outlives the run)
+ */
+class ei_arena_scope_t {
+public:
+    ei_arena_scope_t(ei_arena_t *arena) : previous(ei_arena_t::active()) {
+        ei_arena_t::active() = arena;
+    }
+
+    ~ei_arena_scope_t() {
+        ei_arena_t::active() = previous;
+    }
+
+private:
+    ei_arena_t *previous;
+};
+
 } // namespace ei
 
 // clang-format on
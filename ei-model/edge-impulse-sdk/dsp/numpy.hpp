@@ -1354,6 +1354,11 @@ public:
             src_size = n_fft;
         }
 
+        fft_plan_t *plan = get_fft_plan(n_fft);
+        if (plan) {
+            return run_fft_plan(plan, src, src_size, output);
+        }
+
         // Unfortunately, arm fft (at least) modifies the input buffer AND does not work in place
         // So we have to copy the input to a new buffer
         EI_DSP_MATRIX(fft_input, 1, n_fft);
@@ -1739,6 +1744,115 @@ public:
         return EIDSP_OK;
     }
 
+    /**
+     * Real FFT plan and scratch buffers for one FFT length, kept between calls so
+     * FFTs of the same length don't allocate
+     */
+    typedef struct {
+        size_t n_fft;
+        float *input;               // n_fft points, the FFT input (zero-padded)
+        fft_complex_t *output;      // n_fft / 2 + 1 complex bins
+        float *power;               // n_fft / 2 + 1 power bins, used by welch_max_hold
+        kiss_fftr_cfg kiss_cfg;     // software plan, only created when the HW FFT fails
+        size_t kiss_mem_length;
+    } fft_plan_t;
+
+    /**
+     * Get the cached plan for an FFT length, creating it on first use
+     * @param n_fft FFT length
+     * @returns the plan, or nullptr if the cache is full or out of memory
+     */
+    static fft_plan_t *get_fft_plan(size_t n_fft)
+    {
+#if EIDSP_FFT_PLAN_CACHE_SIZE > 0
+        fft_plan_t *plans = fft_plan_cache();
+        fft_plan_t *plan = nullptr;
+
+        for (size_t ix = 0; ix < EIDSP_FFT_PLAN_CACHE_SIZE; ix++) {
+            if (plans[ix].n_fft == n_fft) {
+                return &plans[ix];
+            }
+            if (!plan && plans[ix].n_fft == 0) {
+                plan = &plans[ix];
+            }
+        }
+        if (!plan) {
+            return nullptr;
+        }
+
+        const size_t n_fft_out_features = n_fft / 2 + 1;
+        plan->input = (float *)ei_dsp_calloc(n_fft, sizeof(float));
+        plan->output = (fft_complex_t *)ei_dsp_calloc(n_fft_out_features, sizeof(fft_complex_t));
+        plan->power = (float *)ei_dsp_calloc(n_fft_out_features, sizeof(float));
+        plan->n_fft = n_fft;
+        if (!plan->input || !plan->output || !plan->power) {
+            free_fft_plan(plan);
+            return nullptr;
+        }
+        return plan;
+#else
+        (void)n_fft;
+        return nullptr;
+#endif // EIDSP_FFT_PLAN_CACHE_SIZE > 0
+    }
+
+    /**
+     * Release all cached FFT plans. Invoke when the impulse is no longer used.
+     * The cache isn't locked, call this from the thread that runs the DSP and never
+     * while it may be inside an FFT (run_classifier_deinit() on the inference thread).
+     */
+    static void clear_fft_plans()
+    {
+#if EIDSP_FFT_PLAN_CACHE_SIZE > 0
+        fft_plan_t *plans = fft_plan_cache();
+        for (size_t ix = 0; ix < EIDSP_FFT_PLAN_CACHE_SIZE; ix++) {
+            free_fft_plan(&plans[ix]);
+        }
+#endif // EIDSP_FFT_PLAN_CACHE_SIZE > 0
+    }
+
+    /**
+     * Run a real FFT through a cached plan. Copies (and zero pads) src into the
+     * plan's input buffer, so src is left untouched.
+     * @param plan Plan from get_fft_plan
+     * @param src Source buffer
+     * @param src_size Size of the source buffer, at most plan->n_fft
+     * @param output Output buffer of plan->n_fft / 2 + 1 bins
+     * @returns 0 if OK
+     */
+    static int run_fft_plan(fft_plan_t *plan, const float *src, size_t src_size, fft_complex_t *output)
+    {
+        const size_t n_fft = plan->n_fft;
+
+        memcpy(plan->input, src, src_size * sizeof(float));
+        memset(plan->input + src_size, 0, (n_fft - src_size) * sizeof(float));
+
+        auto res = ei::fft::hw_r2c_fft(plan->input, output, n_fft);
+        if (!handle_fft_hw_failure(res, n_fft)) {
+            return EIDSP_OK;
+        }
+
+    #if EIDSP_INCLUDE_KISSFFT || !defined(EIDSP_INCLUDE_KISSFFT)
+        // HW FFT may have modified the input, copy it again
+        memcpy(plan->input, src, src_size * sizeof(float));
+        memset(plan->input + src_size, 0, (n_fft - src_size) * sizeof(float));
+
+        if (!plan->kiss_cfg) {
+            plan->kiss_cfg = kiss_fftr_alloc(n_fft, 0, NULL, NULL, &plan->kiss_mem_length);
+            if (!plan->kiss_cfg) {
+                EIDSP_ERR(EIDSP_OUT_OF_MEM);
+            }
+            ei_dsp_register_alloc(plan->kiss_mem_length, plan->kiss_cfg);
+        }
+
+        kiss_fftr(plan->kiss_cfg, plan->input, (kiss_fft_cpx*)output);
+
+        return EIDSP_OK;
+    #else
+        return EIDSP_NOT_SUPPORTED;
+    #endif
+    }
+
     static int software_rfft(float *fft_input, fft_complex_t *output, size_t n_fft, size_t n_fft_out_features)
     {
     #if EIDSP_INCLUDE_KISSFFT || !defined(EIDSP_INCLUDE_KISSFFT)
@@ -2051,6 +2165,22 @@ public:
             EIDSP_ERR(EIDSP_MATRIX_SIZE_MISMATCH);
         }
 
+        fft_plan_t *plan = get_fft_plan(fft_points);
+        if (plan) {
+            if (frame_size > fft_points) {
+                frame_size = fft_points;
+            }
+            EI_TRY(run_fft_plan(plan, frame, frame_size, plan->output));
+
+            // |X|^2 / N straight from the complex bins
+            const float scale = 1.0f / static_cast<float>(fft_points);
+            for (size_t ix = 0; ix < out_buffer_size; ix++) {
+                out_buffer[ix] = scale *
+                    (plan->output[ix].r * plan->output[ix].r + plan->output[ix].i * plan->output[ix].i);
+            }
+            return EIDSP_OK;
+        }
+
         int r = numpy::rfft(frame, frame_size, out_buffer, out_buffer_size, fft_points);
         if (r != EIDSP_OK) {
             return r;
@@ -2080,7 +2210,12 @@ public:
         float *fft_out;
         const size_t size = fft_out_size * sizeof(float);
         ei_unique_ptr_t p_fft_out(nullptr, [size](void* ptr){ei::ei_dsp_free_func(ptr, size);});
-        if (input_size < fft_points) {
+        fft_plan_t *plan = get_fft_plan(fft_points);
+        if (plan) {
+            // the plan has its own power buffer, no need to work in place
+            fft_out = plan->power;
+        }
+        else if (input_size < fft_points) {
             fft_out = (float *)ei_dsp_calloc(fft_out_size, sizeof(float));
             p_fft_out.reset(fft_out);
         }
@@ -2465,6 +2600,31 @@ public:
     }
 
 private:
+#if EIDSP_FFT_PLAN_CACHE_SIZE > 0
+    static fft_plan_t *fft_plan_cache()
+    {
+        static fft_plan_t plans[EIDSP_FFT_PLAN_CACHE_SIZE] = { };
+        return plans;
+    }
+
+    static void free_fft_plan(fft_plan_t *plan)
+    {
+        if (plan->input) {
+            ei_dsp_free(plan->input, plan->n_fft * sizeof(float));
+        }
+        if (plan->output) {
+            ei_dsp_free(plan->output, (plan->n_fft / 2 + 1) * sizeof(fft_complex_t));
+        }
+        if (plan->power) {
+            ei_dsp_free(plan->power, (plan->n_fft / 2 + 1) * sizeof(float));
+        }
+        if (plan->kiss_cfg) {
+            ei_dsp_free(plan->kiss_cfg, plan->kiss_mem_length);
+        }
+        memset(plan, 0, sizeof(fft_plan_t));
+    }
+#endif // EIDSP_FFT_PLAN_CACHE_SIZE > 0
+
     /**
      * Helper function to handle FFT hardware acceleration failures and logging
      * @param res Result code from hardware FFT attempt
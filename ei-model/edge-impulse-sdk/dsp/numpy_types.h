@@ -103,6 +103,10 @@ typedef struct ei_matrix {
             buffer = a_buffer;
             buffer_managed_by_me = false;
         }
+        else if ((buffer = (float*)ei_arena_t::scratch_calloc(n_rows * n_cols * sizeof(float))) != NULL) {
+            // scratch memory of the running impulse, released when the arena is reset
+            buffer_managed_by_me = false;
+        }
         else {
             buffer = (float*)ei_calloc(n_rows * n_cols * sizeof(float), 1);
             buffer_managed_by_me = true;
@@ -110,7 +114,7 @@ typedef struct ei_matrix {
         rows = n_rows;
         cols = n_cols;
 
-        if (!a_buffer) {
+        if (buffer_managed_by_me) {
 #if EIDSP_TRACK_ALLOCATIONS
             _fn = fn;
             _file = file;
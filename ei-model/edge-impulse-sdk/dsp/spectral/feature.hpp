@@ -333,6 +333,88 @@ public:
         }
     }
 
+    /**
+     * @brief De-interleaves a [samples][axes] matrix into one row per axis, scaling it and
+     * accumulating the moments of every axis in a single pass over the raw input. The mean
+     * is then removed from every row, so the result matches transpose, scale and subtract_mean.
+     *
+     * @param input_matrix Raw [samples][axes] input, transposed to [axes][samples] in place
+     * @param scale Scale applied to every sample
+     * @param row_stats Out: RMS, skew and kurtosis per axis (3 values per axis)
+     * @return EIDSP_OK if OK
+     */
+    static int deinterleave_and_moments(matrix_t *input_matrix, float scale, float *row_stats)
+    {
+        const size_t samples = input_matrix->rows;
+        const size_t axes = input_matrix->cols;
+        if (samples == 0 || axes == 0) {
+            EIDSP_ERR(EIDSP_MATRIX_SIZE_MISMATCH);
+        }
+
+        EI_DSP_MATRIX(rows, axes, samples);
+
+        // moments are accumulated around the first sample of each axis, which keeps the
+        // raw moment sums small and avoids cancellation when the signal has a large offset
+        ei_vector<double> sums(axes * 4, 0.0);
+        ei_vector<float> shift(axes);
+        for (size_t axis = 0; axis < axes; axis++) {
+            shift[axis] = input_matrix->buffer[axis] * scale;
+        }
+
+        const float *in = input_matrix->buffer;
+        for (size_t ix = 0; ix < samples; ix++) {
+            for (size_t axis = 0; axis < axes; axis++) {
+                const float x = *in++ * scale;
+                rows.buffer[axis * samples + ix] = x;
+
+                const double d = x - shift[axis];
+                const double d2 = d * d;
+                double *sum = &sums[axis * 4];
+                sum[0] += d;
+                sum[1] += d2;
+                sum[2] += d2 * d;
+                sum[3] += d2 * d2;
+            }
+        }
+
+        memcpy(input_matrix->buffer, rows.buffer, samples * axes * sizeof(float));
+        input_matrix->rows = axes;
+        input_matrix->cols = samples;
+
+        for (size_t axis = 0; axis < axes; axis++) {
+            const double *sum = &sums[axis * 4];
+            const double mean = sum[0] / samples;
+            const double e2 = sum[1] / samples;
+            const double e3 = sum[2] / samples;
+            const double e4 = sum[3] / samples;
+            const double mean2 = mean * mean;
+
+            double m2 = e2 - mean2;
+            if (m2 < 0) {
+                m2 = 0;
+            }
+            const double m3 = e3 - 3 * mean * e2 + 2 * mean2 * mean;
+            const double m4 = e4 - 4 * mean * e3 + 6 * mean2 * e2 - 3 * mean2 * mean2;
+
+            float stddev = static_cast<float>(sqrt(m2));
+            row_stats[axis * 3] = stddev;
+            if (stddev == 0.0f) {
+                stddev = 1e-10f;
+            }
+            const float temp = stddev * stddev * stddev;
+            row_stats[axis * 3 + 1] = static_cast<float>(m3) / temp;
+            row_stats[axis * 3 + 2] = (static_cast<float>(m4) / (temp * stddev)) - 3;
+
+            const float row_mean = shift[axis] + static_cast<float>(mean);
+            float *row = input_matrix->get_row_ptr(axis);
+            for (size_t ix = 0; ix < samples; ix++) {
+                row[ix] -= row_mean;
+            }
+        }
+
+        return EIDSP_OK;
+    }
+
     /**
      * @brief Calculates the spectral analysis features.
      *
@@ -346,7 +428,16 @@ public:
         const bool remove_mean = true,
         const bool transpose_and_scale_input = true)
     {
-        if (transpose_and_scale_input) {
+        // without a filter, transpose, scale, mean removal and the moments are fused
+        const bool fused_stats = transpose_and_scale_input && remove_mean &&
+            strcmp(config->filter_type, "low") != 0 && strcmp(config->filter_type, "high") != 0;
+        ei_vector<float> row_stats;
+
+        if (fused_stats) {
+            row_stats.resize(input_matrix->cols * 3);
+            EI_TRY(deinterleave_and_moments(input_matrix, config->scale_axes, row_stats.data()));
+        }
+        else if (transpose_and_scale_input) {
             // transpose the matrix so we have one row per axis
             numpy::transpose_in_place(input_matrix);
 
@@ -382,7 +473,7 @@ public:
             is_high_pass = true;
         }
 
-        if (remove_mean){
+        if (remove_mean && !fused_stats) {
             EI_TRY(processing::subtract_mean(input_matrix));
         }
 
@@ -409,39 +500,46 @@ public:
             float *data_window = input_matrix->get_row_ptr(row);
             size_t data_size = input_matrix->cols;
 
-            matrix_t rms_in_matrix(1, data_size, data_window);
-            matrix_t rms_out_matrix(1, 1, feature_out);
-            EI_TRY(numpy::rms(&rms_in_matrix, &rms_out_matrix));
+            if (fused_stats) {
+                *feature_out++ = row_stats[row * 3];
+                *feature_out++ = row_stats[row * 3 + 1];
+                *feature_out++ = row_stats[row * 3 + 2];
+            }
+            else {
+                matrix_t rms_in_matrix(1, data_size, data_window);
+                matrix_t rms_out_matrix(1, 1, feature_out);
+                EI_TRY(numpy::rms(&rms_in_matrix, &rms_out_matrix));
 
-            feature_out++;
+                feature_out++;
 
-            // Standard Deviation
-            float stddev = *(feature_out-1); //= sqrt(numpy::variance(data_window, data_size));
-            if (stddev == 0.0f) {
-                stddev = 1e-10f;
-            }
-            // Don't add std dev as a feature b/c it's the same as RMS
-            // Skew and Kurtosis w/ shortcut:
-            // See definition at https://en.wikipedia.org/wiki/Skewness
-            // See definition at https://en.wikipedia.org/wiki/Kurtosis
-            // Substitute 0 for mean (b/c it is subtracted out above)
-            // Skew becomes: mean(X^3) / stddev^3
-            // Kurtosis becomes: mean(X^4) / stddev^4
-            // Note, this is the Fisher definition of Kurtosis, so subtract 3
-            // (see https://docs.scipy.org/doc/scipy/reference/generated/scipy.stats.kurtosis.html)
-            float s_sum = 0;
-            float k_sum = 0;
-            float temp;
-            for (size_t i = 0; i < data_size; i++) {
-                temp = data_window[i] * data_window[i] * data_window[i];
-                s_sum += temp;
-                k_sum += temp * data_window[i];
+                // Standard Deviation
+                float stddev = *(feature_out-1); //= sqrt(numpy::variance(data_window, data_size));
+                if (stddev == 0.0f) {
+                    stddev = 1e-10f;
+                }
+                // Don't add std dev as a feature b/c it's the same as RMS
+                // Skew and Kurtosis w/ shortcut:
+                // See definition at https://en.wikipedia.org/wiki/Skewness
+                // See definition at https://en.wikipedia.org/wiki/Kurtosis
+                // Substitute 0 for mean (b/c it is subtracted out above)
+                // Skew becomes: mean(X^3) / stddev^3
+                // Kurtosis becomes: mean(X^4) / stddev^4
+                // Note, this is the Fisher definition of Kurtosis, so subtract 3
+                // (see https://docs.scipy.org/doc/scipy/reference/generated/scipy.stats.kurtosis.html)
+                float s_sum = 0;
+                float k_sum = 0;
+                float temp;
+                for (size_t i = 0; i < data_size; i++) {
+                    temp = data_window[i] * data_window[i] * data_window[i];
+                    s_sum += temp;
+                    k_sum += temp * data_window[i];
+                }
+                // Skewness out
+                temp = stddev * stddev * stddev;
+                *feature_out++ = (s_sum / data_size) / temp;
+                // Kurtosis out
+                *feature_out++ = ((k_sum / data_size) / (temp * stddev)) - 3;
             }
-            // Skewness out
-            temp = stddev * stddev * stddev;
-            *feature_out++ = (s_sum / data_size) / temp;
-            // Kurtosis out
-            *feature_out++ = ((k_sum / data_size) / (temp * stddev)) - 3;
 
             if (config->implementation_version == 4) {
 
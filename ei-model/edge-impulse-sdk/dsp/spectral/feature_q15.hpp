@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+#ifndef _EIDSP_SPECTRAL_FEATURE_Q15_H_
+#define _EIDSP_SPECTRAL_FEATURE_Q15_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "edge-impulse-sdk/dsp/ei_vector.h"
+#include "edge-impulse-sdk/dsp/config.hpp"
+#include "edge-impulse-sdk/dsp/returntypes.hpp"
+#include "edge-impulse-sdk/CMSIS/DSP/Include/dsp/transform_functions.h"
+#include "model-parameters/model_metadata.h"
+
+namespace ei {
+namespace spectral {
+
+/**
+ * Fixed point spectral analysis (FFT, no filter, implementation version 2 and 3),
+ * producing the same features as feature::extract_spec_features, already quantized
+ * for an int8 input tensor.
+ *
+ * Every axis is converted to q15 with its own power-of-two exponent (block floating
+ * point), chosen so the mean removed signal uses the full q15 range. Moments are
+ * accumulated in 64 bit integers, spectra come from the CMSIS-DSP q15 complex FFT
+ * and all features are formed as Q16.16 before they are quantized, so float math is
+ * only used to convert the input samples and the tensor scale.
+ */
+class feature_q15 {
+public:
+
+    /**
+     * Check whether the fixed point path implements a spectral analysis config
+     */
+    static bool is_supported(const ei_dsp_config_spectral_analysis_t *config)
+    {
+        return (config->implementation_version == 2 || config->implementation_version == 3) &&
+            strcmp(config->analysis_type, "FFT") == 0 &&
+            strcmp(config->filter_type, "low") != 0 &&
+            strcmp(config->filter_type, "high") != 0 &&
+            config->fft_length >= 16 && config->fft_length <= 4096 &&
+            (config->fft_length & (config->fft_length - 1)) == 0;
+    }
+
+    /**
+     * Calculate the spectral features of a window and quantize them.
+     * @param input Interleaved samples (samples x axes)
+     * @param samples Number of samples per axis
+     * @param axes Number of axes
+     * @param config Spectral analysis config, see is_supported
+     * @param scale Scale of the output tensor
+     * @param zero_point Zero point of the output tensor
+     * @param output Quantized features, (3 + fft_length / 2) per axis
+     * @param output_f32 Optional, features before quantization (e.g. for anomaly blocks)
+     */
+    static int extract_spec_features_i8(
+        const float *input,
+        size_t samples,
+        size_t axes,
+        const ei_dsp_config_spectral_analysis_t *config,
+        float scale,
+        int32_t zero_point,
+        int8_t *output,
+        float *output_f32 = nullptr)
+    {
+        if (!is_supported(config)) {
+            EIDSP_ERR(EIDSP_NOT_SUPPORTED);
+        }
+        if (samples == 0 || axes == 0 || scale <= 0.0f) {
+            EIDSP_ERR(EIDSP_PARAMETER_INVALID);
+        }
+
+        const size_t fft_length = config->fft_length;
+        const size_t hop = config->do_fft_overlap ? fft_length / 2 : fft_length;
+        const size_t num_bins = fft_length / 2;
+        // the q15 CFFT scales its output down by fft_length
+        const int fft_shift = log2_int(fft_length);
+
+        arm_cfft_instance_q15 fft;
+        if (arm_cfft_init_q15(&fft, fft_length) != ARM_MATH_SUCCESS) {
+            EIDSP_ERR(EIDSP_FFT_SIZE_NOT_SUPPORTED);
+        }
+
+        ei_vector<int16_t> row(samples);
+        ei_vector<int16_t> frame(fft_length * 2);
+        ei_vector<uint32_t> max_power(num_bins);
+
+        const int64_t inv_scale_q16 = static_cast<int64_t>(lroundf(65536.0f / scale));
+        size_t out_ix = 0;
+
+        auto emit = [&](int64_t value_q16) {
+            output[out_ix] = quantize_q16(value_q16, inv_scale_q16, zero_point);
+            if (output_f32) {
+                output_f32[out_ix] = static_cast<float>(value_q16) / 65536.0f;
+            }
+            out_ix++;
+        };
+
+        for (size_t axis = 0; axis < axes; axis++) {
+            // the only float pass: pick the exponent and convert to q15
+            float max_abs = 0.0f;
+            for (size_t ix = 0; ix < samples; ix++) {
+                float x = fabsf(input[ix * axes + axis] * config->scale_axes);
+                max_abs = x > max_abs ? x : max_abs;
+            }
+            // |x| < 2^(exp - 1), so x - mean fits in q15 after scaling by 2^(15 - exp)
+            int exp = 0;
+            if (max_abs > 0.0f) {
+                frexpf(max_abs * 2.0f, &exp);
+            }
+            const float to_q15 = ldexpf(config->scale_axes, 15 - exp);
+
+            int64_t sum = 0;
+            for (size_t ix = 0; ix < samples; ix++) {
+                int32_t x = static_cast<int32_t>(lroundf(input[ix * axes + axis] * to_q15));
+                row[ix] = saturate_q15(x);
+                sum += row[ix];
+            }
+            const int32_t mean = static_cast<int32_t>(div_round(sum, static_cast<int64_t>(samples)));
+
+            int32_t max_dev = 0;
+            for (size_t ix = 0; ix < samples; ix++) {
+                row[ix] = saturate_q15(row[ix] - mean);
+                int32_t d = row[ix] < 0 ? -row[ix] : row[ix];
+                max_dev = d > max_dev ? d : max_dev;
+            }
+            // normalize so the largest deviation uses the full q15 range
+            int shift = 0;
+            while (max_dev > 0 && (max_dev << (shift + 1)) < 32768) {
+                shift++;
+            }
+            // value = row * 2^row_exp
+            const int row_exp = exp - 15 - shift;
+
+            int64_t m2 = 0, m3 = 0, m4 = 0;
+            for (size_t ix = 0; ix < samples; ix++) {
+                int32_t d = row[ix] * (1 << shift);
+                row[ix] = static_cast<int16_t>(d);
+                int64_t d2 = static_cast<int64_t>(d) * d;
+                m2 += d2;
+                m3 += d2 * d;
+                // (d^2 / 2^15)^2, d^4 doesn't fit 64 bits once summed
+                int64_t d2_q15 = (d2 + (1 << 14)) >> 15;
+                m4 += d2_q15 * d2_q15;
+            }
+
+            const int64_t n = static_cast<int64_t>(samples);
+            const int64_t var = m2 / n;
+            const int64_t var_q8 = (m2 << 8) / n;
+            const int64_t sd_q8 = isqrt64((m2 << 16) / n);
+
+            // RMS of the mean removed signal (the standard deviation)
+            emit(shift_q(sd_q8, 8 + row_exp));
+
+            // skewness: E[d^3] / sd^3
+            const int64_t sd3 = (var_q8 * sd_q8) >> 16;
+            emit(sd3 > 0 ? ((m3 / n) * 65536) / sd3 : 0);
+
+            // kurtosis (Fisher): E[d^4] / var^2 - 3, m4 is in units of 2^30
+            const int64_t var2 = (var * var) >> 30;
+            emit((var2 > 0 ? (m4 << 16) / (n * var2) : 0) - (3 << 16));
+
+            // max hold of the power spectra of all (zero padded) frames
+            memset(max_power.data(), 0, num_bins * sizeof(uint32_t));
+            for (size_t start = 0; start < samples; start += hop) {
+                size_t points = samples - start < fft_length ? samples - start : fft_length;
+                memset(frame.data(), 0, fft_length * 2 * sizeof(int16_t));
+                for (size_t ix = 0; ix < points; ix++) {
+                    frame[ix * 2] = row[start + ix];
+                }
+                arm_cfft_q15(&fft, frame.data(), 0, 1);
+
+                for (size_t bin = 0; bin < num_bins; bin++) {
+                    int32_t re = frame[(bin + 1) * 2];
+                    int32_t im = frame[(bin + 1) * 2 + 1];
+                    uint32_t power = static_cast<uint32_t>(re * re) + static_cast<uint32_t>(im * im);
+                    max_power[bin] = power > max_power[bin] ? power : max_power[bin];
+                }
+            }
+
+            // |X|^2 / N with X = bin * fft_length * 2^row_exp
+            const int power_exp = fft_shift + 2 * row_exp;
+            for (size_t bin = 0; bin < num_bins; bin++) {
+                if (!config->do_log) {
+                    emit(shift_q(max_power[bin], 16 + power_exp));
+                }
+                else if (max_power[bin] == 0) {
+                    // same as zero_handling in the float path, log10(1e-10)
+                    emit(-10 * 65536);
+                }
+                else {
+                    int64_t log2_q16 = log2_q16_int(max_power[bin]) + static_cast<int64_t>(power_exp) * 65536;
+                    // log10(x) = log2(x) * log10(2), 19728 is log10(2) in Q16
+                    emit(div_round(log2_q16 * 19728, 65536));
+                }
+            }
+        }
+
+        return EIDSP_OK;
+    }
+
+private:
+    static int log2_int(size_t value)
+    {
+        int bits = 0;
+        while (value > 1) {
+            value >>= 1;
+            bits++;
+        }
+        return bits;
+    }
+
+    static int16_t saturate_q15(int32_t value)
+    {
+        return static_cast<int16_t>(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+
+    static int64_t div_round(int64_t num, int64_t den)
+    {
+        return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+    }
+
+    // value * 2^bits, rounded, saturated to Q16.16 range
+    static int64_t shift_q(int64_t value, int bits)
+    {
+        if (bits >= 0) {
+            if (bits > 31 || value > (INT64_C(1) << (62 - bits))) {
+                return INT32_MAX;
+            }
+            return value << bits;
+        }
+        if (bits < -62) {
+            return 0;
+        }
+        return (value + (INT64_C(1) << (-bits - 1))) >> -bits;
+    }
+
+    static int64_t isqrt64(int64_t value)
+    {
+        uint64_t op = static_cast<uint64_t>(value);
+        uint64_t res = 0;
+        uint64_t one = UINT64_C(1) << 62;
+
+        while (one > op) {
+            one >>= 2;
+        }
+        while (one != 0) {
+            if (op >= res + one) {
+                op -= res + one;
+                res = (res >> 1) + one;
+            }
+            else {
+                res >>= 1;
+            }
+            one >>= 2;
+        }
+        return static_cast<int64_t>(res);
+    }
+
+    // log2 of a positive integer in Q16, fraction bits by repeated squaring
+    static int64_t log2_q16_int(uint32_t value)
+    {
+        int integer = 31;
+        while (!(value & 0x80000000u)) {
+            value <<= 1;
+            integer--;
+        }
+        // mantissa in [1, 2) as Q31
+        uint64_t m = value;
+        int64_t frac = 0;
+        for (int bit = 15; bit >= 0; bit--) {
+            m = (m * m) >> 31;
+            if (m >= (UINT64_C(1) << 32)) {
+                m >>= 1;
+                frac |= INT64_C(1) << bit;
+            }
+        }
+        return (static_cast<int64_t>(integer) << 16) + frac;
+    }
+
+    static int8_t quantize_q16(int64_t value_q16, int64_t inv_scale_q16, int32_t zero_point)
+    {
+        if (value_q16 > INT32_MAX) {
+            value_q16 = INT32_MAX;
+        }
+        else if (value_q16 < INT32_MIN) {
+            value_q16 = INT32_MIN;
+        }
+        int64_t q = div_round(value_q16 * inv_scale_q16, INT64_C(1) << 32) + zero_point;
+        return static_cast<int8_t>(q > 127 ? 127 : (q < -128 ? -128 : q));
+    }
+};
+
+} // namespace spectral
+} // namespace ei
+
+#endif // _EIDSP_SPECTRAL_FEATURE_Q15_H_
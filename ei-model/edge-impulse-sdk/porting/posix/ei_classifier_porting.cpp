@@ -33,6 +33,7 @@
  */
 
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #if EI_PORTING_POSIX == 1
 
 #include <inttypes.h>
@@ -76,6 +77,22 @@ uint64_t ei_read_timer_us() {
     return (s * 1000000) + us;
 }
 
+#if EI_TRACE_ENABLED
+// nanoseconds of the monotonic clock, wall time rather than process time,
+// so waits show up in the trace
+uint32_t ei_trace_read_cycles(void) {
+    struct timespec spec;
+
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+
+    return (uint32_t)((uint64_t)spec.tv_sec * 1000000000ULL + (uint64_t)spec.tv_nsec);
+}
+
+uint64_t ei_trace_cycles_to_ns(uint64_t cycles) {
+    return cycles;
+}
+#endif
+
 __attribute__((weak)) void ei_printf(const char *format, ...) {
     va_list myargs;
     va_start(myargs, format);
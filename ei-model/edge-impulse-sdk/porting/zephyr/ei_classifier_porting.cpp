@@ -46,6 +46,14 @@
 #endif
 #include <stdio.h>
 #include <stdlib.h>
+#include "edge-impulse-sdk/dsp/ei_trace.h"
+#if EI_TRACE_ENABLED
+#if (KERNEL_VERSION_MAJOR > 3) || ((KERNEL_VERSION_MAJOR == 3) && (KERNEL_VERSION_MINOR >= 1))
+#include <zephyr/timing/timing.h>
+#else
+#include <timing/timing.h>
+#endif
+#endif
 
 extern const struct device *uart;
 
@@ -65,9 +73,33 @@ uint64_t ei_read_timer_ms() {
 }
 
 uint64_t ei_read_timer_us() {
-    return k_uptime_get() * 1000;
+    return k_ticks_to_us_floor64(k_uptime_ticks());
 }
 
+#if EI_TRACE_ENABLED
+// timing API is backed by the DWT cycle counter on Cortex-M cores that have it
+void ei_trace_port_init(void)
+{
+    timing_init();
+    timing_start();
+}
+
+uint32_t ei_trace_read_cycles(void)
+{
+    return (uint32_t)timing_counter_get();
+}
+
+uint64_t ei_trace_cycles_to_ns(uint64_t cycles)
+{
+    return timing_cycles_to_ns(cycles);
+}
+
+uint32_t ei_trace_thread_id(void)
+{
+    return (uint32_t)(uintptr_t)k_current_get();
+}
+#endif
+
 EI_WEAK_FN char ei_getchar()
 {
     uint8_t rcv_char = 0;
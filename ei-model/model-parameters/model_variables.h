@@ -81,7 +81,11 @@ ei_model_dsp_t ei_dsp_blocks[ei_dsp_blocks_size] = {
 const ei_config_tflite_eon_graph_t ei_config_tflite_graph_3 = {
     .implementation_version = 1,
     .model_init = &tflite_learn_3_init,
+#if EI_CLASSIFIER_TFLITE_EON_DENSE == 1
+    .model_invoke = &tflite_learn_3_invoke_dense,
+#else
     .model_invoke = &tflite_learn_3_invoke,
+#endif
     .model_reset = &tflite_learn_3_reset,
     .model_input = &tflite_learn_3_input,
     .model_output = &tflite_learn_3_output,
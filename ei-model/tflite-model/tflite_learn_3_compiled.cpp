@@ -36,6 +36,13 @@
 #include "edge-impulse-sdk/tensorflow/lite/c/common.h"
 #include "edge-impulse-sdk/tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#if EI_CLASSIFIER_TFLITE_EON_DENSE == 1
+#include "edge-impulse-sdk/classifier/inferencing_engines/tflite_eon_dense.h"
+#include "edge-impulse-sdk/tensorflow/lite/kernels/internal/quantization_util.h"
+#include "edge-impulse-sdk/tensorflow/lite/kernels/kernel_util.h"
+#endif // EI_CLASSIFIER_TFLITE_EON_DENSE
 
 #if EI_CLASSIFIER_PRINT_STATE
 #if defined(__cplusplus) && EI_C_LINKAGE == 1
@@ -145,6 +152,9 @@ static TfLiteTensorWithIndex tflTensors[MAX_TFL_TENSOR_COUNT];
 static const int MAX_TFL_EVAL_COUNT = 4;
 static TfLiteEvalTensorWithIndex tflEvalTensors[MAX_TFL_EVAL_COUNT];
 TfLiteRegistration registrations[OP_LAST];
+#if EI_TRACE_ENABLED
+static const char *const used_operator_names[OP_LAST] = { "FULLY_CONNECTED", "SOFTMAX", };
+#endif
 
 namespace g0 {
 const TfArray<2, int> tensor_dimension0 = { 2, { 1,33 } };
@@ -357,6 +367,91 @@ static void init_tflite_eval_tensor(int i, TfLiteEvalTensor *tensor) {
 #endif // EI_CLASSIFIER_ALLOCATION_HEAP
 }
 
+#if EI_CLASSIFIER_TFLITE_EON_DENSE == 1
+// FULLY_CONNECTED layers (input tensor, weights, bias, output tensor) with the requantization
+// Prepare computes from the tensor scales, and their specialized kernels
+namespace dense {
+// the constants are defined once, the kernel types are instantiated from this table
+struct layer_t {
+  int input, weights, bias, output;
+  int input_size, output_size;
+  int32_t input_offset, output_offset;
+  int32_t multiplier;
+  int shift;
+  int32_t act_min, act_max;
+};
+
+static constexpr layer_t layers[3] = {
+  { 0, 6, 5, 7, 33, 21, 107, -128, 1618843785, -5, -128, 127 },
+  { 7, 4, 3, 8, 21, 14, 128, -128, 1420479831, -6, -128, 127 },
+  { 8, 2, 1, 9, 14, 4, 128, -22, 1438067748, -8, -128, 127 },
+};
+
+template <size_t Ix>
+using kernel_t = ei::eon_dense::fully_connected_s8<
+  layers[Ix].input_size, layers[Ix].output_size, layers[Ix].input_offset, layers[Ix].output_offset,
+  layers[Ix].multiplier, layers[Ix].shift, layers[Ix].act_min, layers[Ix].act_max>;
+
+static const size_t softmax_node = 3;
+
+static int8_t *tensor_data(int i) {
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+  if (tensorData[i].allocation_type == kTfLiteArenaRw) {
+    return (int8_t*)((uintptr_t)tensorData[i].data + (uintptr_t)tensor_arena);
+  }
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+  return (int8_t*)tensorData[i].data;
+}
+
+template <size_t Ix>
+static void invoke_layer() {
+  kernel_t<Ix>::invoke(tensor_data(layers[Ix].input), tensor_data(layers[Ix].weights),
+                       reinterpret_cast<const int32_t*>(tensor_data(layers[Ix].bias)),
+                       tensor_data(layers[Ix].output));
+}
+
+// set by check_layers(), the specialized kernels are only used when all constants match
+static bool layers_match = false;
+
+// the constants are generated, make sure they still match the tensors
+static bool check_layers() {
+  for (size_t ix = 0; ix < sizeof(layers) / sizeof(layers[0]); ix++) {
+    TfLiteTensor input, weights, output;
+    init_tflite_tensor(layers[ix].input, &input);
+    init_tflite_tensor(layers[ix].weights, &weights);
+    init_tflite_tensor(layers[ix].output, &output);
+
+    const double real_multiplier = static_cast<double>(input.params.scale * weights.params.scale) /
+      static_cast<double>(output.params.scale);
+    int32_t multiplier;
+    int shift;
+    tflite::QuantizeMultiplier(real_multiplier, &multiplier, &shift);
+
+    const TfLiteFullyConnectedParams *params =
+      static_cast<const TfLiteFullyConnectedParams*>(tflNodes[ix].builtin_data);
+    int32_t act_min, act_max;
+    if (tflite::CalculateActivationRangeQuantized(&ctx, params->activation, &output,
+                                                  &act_min, &act_max) != kTfLiteOk) {
+      return false;
+    }
+
+    if (weights.dims->size != 2 || weights.dims->data[0] != layers[ix].output_size ||
+        weights.dims->data[1] != layers[ix].input_size ||
+        multiplier != layers[ix].multiplier || shift != layers[ix].shift ||
+        input.params.zero_point != -layers[ix].input_offset ||
+        output.params.zero_point != layers[ix].output_offset ||
+        weights.params.zero_point != 0 ||
+        act_min != layers[ix].act_min || act_max != layers[ix].act_max) {
+      ei_printf("WARN: Specialized FULLY_CONNECTED layer %d does not match the model, "
+                "using the regular kernels\n", (int)ix);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace dense
+#endif // EI_CLASSIFIER_TFLITE_EON_DENSE
+
 static void* overflow_buffers[EI_MAX_OVERFLOW_BUFFER_COUNT];
 static size_t overflow_buffers_ix = 0;
 static void * AllocatePersistentBufferImpl(struct TfLiteContext* ctx,
@@ -600,6 +695,10 @@ TfLiteStatus tflite_learn_3_init( void*(*alloc_fnc)(size_t,size_t) ) {
   }
   current_subgraph_index = 0;
 
+#if EI_CLASSIFIER_TFLITE_EON_DENSE == 1
+  dense::layers_match = dense::check_layers();
+#endif // EI_CLASSIFIER_TFLITE_EON_DENSE
+
   return kTfLiteOk;
 }
 
@@ -617,7 +716,11 @@ TfLiteStatus tflite_learn_3_invoke() {
   for (size_t i = 0; i < 4; ++i) {
     ResetTensors();
 
-    TfLiteStatus status = registrations[used_ops[i]].invoke(&ctx, &tflNodes[i]);
+    TfLiteStatus status;
+    {
+      EI_TRACE_ZONE(used_operator_names[used_ops[i]]);
+      status = registrations[used_ops[i]].invoke(&ctx, &tflNodes[i]);
+    }
 
 #if EI_CLASSIFIER_PRINT_STATE
     ei_printf("layer %lu\n", i);
@@ -685,6 +788,36 @@ TfLiteStatus tflite_learn_3_invoke() {
   return kTfLiteOk;
 }
 
+#if EI_CLASSIFIER_TFLITE_EON_DENSE == 1
+TfLiteStatus tflite_learn_3_invoke_dense() {
+  if (!dense::layers_match) {
+    return tflite_learn_3_invoke();
+  }
+
+  {
+    EI_TRACE_ZONE(used_operator_names[OP_FULLY_CONNECTED]);
+    dense::invoke_layer<0>();
+  }
+  {
+    EI_TRACE_ZONE(used_operator_names[OP_FULLY_CONNECTED]);
+    dense::invoke_layer<1>();
+  }
+  {
+    EI_TRACE_ZONE(used_operator_names[OP_FULLY_CONNECTED]);
+    dense::invoke_layer<2>();
+  }
+
+  // softmax keeps the regular kernel, it's a single small op
+  ResetTensors();
+  TfLiteStatus status;
+  {
+    EI_TRACE_ZONE(used_operator_names[OP_SOFTMAX]);
+    status = registrations[OP_SOFTMAX].invoke(&ctx, &tflNodes[dense::softmax_node]);
+  }
+  return status;
+}
+#endif // EI_CLASSIFIER_TFLITE_EON_DENSE
+
 TfLiteStatus tflite_learn_3_reset( void (*free_fnc)(void* ptr) ) {
 #ifdef EI_CLASSIFIER_ALLOCATION_HEAP
   free_fnc(tensor_arena);
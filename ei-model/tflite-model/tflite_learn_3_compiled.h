@@ -43,6 +43,9 @@ TfLiteStatus tflite_learn_3_input(int index, TfLiteTensor* tensor);
 TfLiteStatus tflite_learn_3_output(int index, TfLiteTensor* tensor);
 // Runs inference for the model.
 TfLiteStatus tflite_learn_3_invoke();
+// Runs inference with kernels specialized for this model (EI_CLASSIFIER_TFLITE_EON_DENSE),
+// or with the regular kernels if init found they no longer match the tensors.
+TfLiteStatus tflite_learn_3_invoke_dense();
 //Frees memory allocated
 TfLiteStatus tflite_learn_3_reset( void (*free)(void* ptr) );
 
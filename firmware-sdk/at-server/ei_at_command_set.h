@@ -72,8 +72,8 @@
 #define AT_READFILE_ARGS             "FILENAME,[USEMAXRATE]"
 #define AT_READFILE_HELP_TEXT        "Read a specific file (as base64)"
 #define AT_READBUFFER                "READBUFFER"
-#define AT_READBUFFER_ARGS           "START,LENGTH,[USEMAXRATE]"
-#define AT_READBUFFER_HELP_TEXT      "Read from the temporary buffer (as base64)"
+#define AT_READBUFFER_ARGS           "START,LENGTH,[USEMAXRATE],[FRAMED]"
+#define AT_READBUFFER_HELP_TEXT      "Read from the temporary buffer (as base64 or binary frames)"
 #define AT_UNLINKFILE                "UNLINKFILE"
 #define AT_UNLINKFILE_ARGS           "FILE"
 #define AT_UNLINKFILE_HELP_TEXT      "Unlink a specific file"
@@ -88,8 +88,8 @@
 #define AT_RUNIMPULSECONT            "RUNIMPULSECONT"
 #define AT_RUNIMPULSECONT_HELP_TEXT  "Run the impulse continuously"
 #define AT_RUNIMPULSESTATIC          "RUNIMPULSESTATIC"
-#define AT_RUNIMPULSESTATIC_ARGS     "DEBUG,LENGTH"
-#define AT_RUNIMPULSESTATIC_HELP_TEXT "Run the impulse on static data (base64 encoded)"
+#define AT_RUNIMPULSESTATIC_ARGS     "DEBUG,LENGTH,[FRAMED]"
+#define AT_RUNIMPULSESTATIC_HELP_TEXT "Run the impulse on static data (base64 encoded or binary frames)"
 #define AT_INGESTIONCYCLESETTINGS            "INGESTIONCYCLESETTINGS"
 #define AT_INGESTIONCYCLESETTINGS_ARGS       "SENSOR_LABEL,TOTAL_INGESTION_TIME_MS,INTERVAL_TIME_MS"
 #define AT_INGESTIONCYCLESETTINGS_HELP_TEXT  "Set ingestion cycle settings"
@@ -126,6 +126,16 @@
 #define AT_BOOTMODE_HELP_TEXT       "Jump to bootloader"
 #define AT_INFO                     "INFO"
 #define AT_INFO_HELP_TEXT           "Prints details about compiled firmware and ML model"
+#define AT_BENCHIMPULSE             "BENCHIMPULSE"
+#define AT_BENCHIMPULSE_ARGS        "ITERATIONS"
+#define AT_BENCHIMPULSE_HELP_TEXT   "Rerun the impulse on the last static data and print timing histograms"
+#define AT_CLASSIFYBUFFER           "CLASSIFYBUFFER"
+#define AT_CLASSIFYBUFFER_ARGS      "START,LENGTH,STRIDE,[QUIET]"
+#define AT_CLASSIFYBUFFER_HELP_TEXT "Run the impulse over a recording in the temporary buffer, moving the window STRIDE frames at a time"
+#define AT_TRACEDUMP                "TRACEDUMP"
+#define AT_TRACEDUMP_HELP_TEXT      "Print the trace ring as Chrome trace JSON"
+#define AT_TRACECLEAR               "TRACECLEAR"
+#define AT_TRACECLEAR_HELP_TEXT     "Clear the trace ring"
 
 /*************************************************************************************************/
 /* HELP is not necessary as it is built-in into ATServer and
@@ -228,6 +228,38 @@ int base64_encode_buffer(const char *input, size_t input_size, char *output, siz
     return output_ix;
 }
 
+/**
+ * @brief Base64 encode a whole block into a buffer, 3 input bytes at a time
+ *
+ * @param input
+ * @param input_size
+ * @param output buffer of at least base64_encoded_size(input_size) bytes
+ * @return size_t number of characters written to output
+ */
+size_t base64_encode_block(const uint8_t *input, size_t input_size, char *output)
+{
+    char *out = output;
+
+    for (; input_size >= 3; input_size -= 3, input += 3, out += 4) {
+        const uint32_t word = ((uint32_t)input[0] << 16) | ((uint32_t)input[1] << 8) | input[2];
+        out[0] = base64_chars[(word >> 18) & 0x3f];
+        out[1] = base64_chars[(word >> 12) & 0x3f];
+        out[2] = base64_chars[(word >> 6) & 0x3f];
+        out[3] = base64_chars[word & 0x3f];
+    }
+
+    if (input_size) {
+        const uint32_t word = ((uint32_t)input[0] << 16) | (input_size > 1 ? ((uint32_t)input[1] << 8) : 0);
+        out[0] = base64_chars[(word >> 18) & 0x3f];
+        out[1] = base64_chars[(word >> 12) & 0x3f];
+        out[2] = input_size > 1 ? base64_chars[(word >> 6) & 0x3f] : '=';
+        out[3] = '=';
+        out += 4;
+    }
+
+    return out - output;
+}
+
 std::vector<unsigned char> base64_decode(std::string const& encoded_string) {
   int in_len = encoded_string.size();
   int i = 0;
@@ -62,6 +62,7 @@
 
 */
 
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -71,6 +72,15 @@ void base64_encode(const char *input, size_t input_size, void (*putc_f)(char));
 void base64_encode_chunk(const char *input, size_t input_size, void (*putc_f)(char));
 void base64_encode_finish(void (*putc_f)(char));
 int base64_encode_buffer(const char *input, size_t input_size, char *output, size_t output_size);
+size_t base64_encode_block(const uint8_t *input, size_t input_size, char *output);
 std::vector<unsigned char> base64_decode(std::string const&);
 
+/**
+ * @brief Number of characters base64_encode_block writes for input_size bytes
+ */
+static inline size_t base64_encoded_size(size_t input_size)
+{
+    return ((input_size + 2) / 3) * 4;
+}
+
 #endif /* EI_AT_BASE64_LIB_H */
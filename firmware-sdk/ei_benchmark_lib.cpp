@@ -0,0 +1,211 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_benchmark_lib.h"
+#include "ei_device_lib.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_types.h"
+#include "edge-impulse-sdk/dsp/memory.hpp"
+#include <string.h>
+
+extern "C" EI_IMPULSE_ERROR run_classifier(
+    ei::signal_t *signal,
+    ei_impulse_result_t *result,
+    bool debug);
+
+/* Private types ----------------------------------------------------------- */
+typedef enum {
+    BENCH_DSP = 0,
+    BENCH_CLASSIFICATION,
+    BENCH_ANOMALY,
+    BENCH_POSTPROCESSING,
+    BENCH_TOTAL,
+    BENCH_COUNT
+} bench_stage_t;
+
+/* Private variables ------------------------------------------------------- */
+static const char *bench_stage_names[BENCH_COUNT] = {
+    "DSP",
+    "Classification",
+    "Anomaly",
+    "Postprocessing",
+    "Total"
+};
+
+/* Private functions ------------------------------------------------------- */
+static size_t hist_bucket(uint64_t value)
+{
+    const uint64_t sub_buckets = 1 << EI_BENCH_HIST_SUB_BITS;
+
+    if (value < sub_buckets) {
+        return (size_t)value;
+    }
+
+    int msb = 63 - __builtin_clzll(value);
+    if (msb >= EI_BENCH_HIST_MAX_BITS) {
+        return EI_BENCH_HIST_BUCKETS - 1;
+    }
+
+    size_t sub = (size_t)(value >> (msb - EI_BENCH_HIST_SUB_BITS)) & (sub_buckets - 1);
+    return sub_buckets + ((msb - EI_BENCH_HIST_SUB_BITS) << EI_BENCH_HIST_SUB_BITS) + sub;
+}
+
+static uint64_t hist_bucket_upper(size_t bucket)
+{
+    const uint64_t sub_buckets = 1 << EI_BENCH_HIST_SUB_BITS;
+
+    if (bucket < sub_buckets) {
+        return bucket;
+    }
+
+    int shift = (int)((bucket - sub_buckets) >> EI_BENCH_HIST_SUB_BITS);
+    uint64_t sub = bucket & (sub_buckets - 1);
+    return ((sub_buckets + sub + 1) << shift) - 1;
+}
+
+static void print_ms(const char *name, uint64_t value_us)
+{
+    ei_printf(" %s %.3f", name, value_us / 1000.f);
+}
+
+/* Public functions -------------------------------------------------------- */
+void ei_bench_hist_add(ei_bench_histogram_t *hist, uint64_t value_us)
+{
+    hist->counts[hist_bucket(value_us)]++;
+    hist->total++;
+    hist->sum += value_us;
+    if (value_us > hist->max) {
+        hist->max = value_us;
+    }
+}
+
+uint64_t ei_bench_hist_percentile(const ei_bench_histogram_t *hist, float percentile)
+{
+    if (hist->total == 0) {
+        return 0;
+    }
+
+    uint32_t rank = (uint32_t)(percentile * hist->total + 0.999f);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint32_t seen = 0;
+    for (size_t ix = 0; ix < EI_BENCH_HIST_BUCKETS; ix++) {
+        seen += hist->counts[ix];
+        if (seen >= rank) {
+            // the last bucket has no upper bound
+            if (ix == EI_BENCH_HIST_BUCKETS - 1) {
+                return hist->max;
+            }
+            uint64_t upper = hist_bucket_upper(ix);
+            return upper < hist->max ? upper : hist->max;
+        }
+    }
+
+    return hist->max;
+}
+
+void ei_bench_hist_print(const char *name, const ei_bench_histogram_t *hist)
+{
+    ei_printf("%-15s", name);
+    print_ms("mean", hist->total > 0 ? hist->sum / hist->total : 0);
+    print_ms("p50", ei_bench_hist_percentile(hist, 0.5f));
+    print_ms("p90", ei_bench_hist_percentile(hist, 0.9f));
+    print_ms("p99", ei_bench_hist_percentile(hist, 0.99f));
+    print_ms("max", hist->max);
+    ei_printf("\r\n");
+}
+
+bool ei_benchmark_impulse(ei::signal_t *signal, uint32_t iterations)
+{
+    ei_bench_histogram_t *hist = (ei_bench_histogram_t *)ei_calloc(BENCH_COUNT, sizeof(ei_bench_histogram_t));
+    if (hist == nullptr) {
+        ei_printf("ERR: Memory allocation for histograms failed\r\n");
+        return false;
+    }
+
+    size_t memory_baseline = ei_memory_in_use;
+    ei_memory_peak_use = ei_memory_in_use;
+    bool success = true;
+
+    ei_printf("Running impulse %u times...\r\n", (unsigned)iterations);
+
+    for (uint32_t it = 0; it < iterations; it++) {
+        ei_impulse_result_t result;
+        memset(&result, 0, sizeof(result));
+
+        uint64_t start_us = ei_read_timer_us();
+        EI_IMPULSE_ERROR res = run_classifier(signal, &result, false);
+        uint64_t total_us = ei_read_timer_us() - start_us;
+
+        if (res != EI_IMPULSE_OK) {
+            ei_printf("ERR: Failed to run classifier (%d)\r\n", res);
+            success = false;
+            break;
+        }
+
+        uint64_t blocks_us = result.timing.dsp_us + result.timing.classification_us + result.timing.anomaly_us;
+
+        ei_bench_hist_add(&hist[BENCH_DSP], result.timing.dsp_us);
+        ei_bench_hist_add(&hist[BENCH_CLASSIFICATION], result.timing.classification_us);
+        ei_bench_hist_add(&hist[BENCH_ANOMALY], result.timing.anomaly_us);
+        ei_bench_hist_add(&hist[BENCH_POSTPROCESSING], total_us > blocks_us ? total_us - blocks_us : 0);
+        ei_bench_hist_add(&hist[BENCH_TOTAL], total_us);
+
+        if (ei_user_invoke_stop_lib()) {
+            ei_printf("Benchmark stopped by user\r\n");
+            success = false;
+            break;
+        }
+    }
+
+    if (hist[BENCH_TOTAL].total > 0) {
+        ei_printf("Iterations: %u, timing in ms\r\n", (unsigned)hist[BENCH_TOTAL].total);
+        for (int stage = 0; stage < BENCH_COUNT; stage++) {
+            ei_bench_hist_print(bench_stage_names[stage], &hist[stage]);
+        }
+
+        if (ei_memory_peak_use > memory_baseline) {
+            ei_printf("Heap peak: %u bytes\r\n", (unsigned)(ei_memory_peak_use - memory_baseline));
+        }
+        else {
+            ei_printf("Heap peak: n/a (build with EIDSP_TRACK_ALLOCATIONS=1)\r\n");
+        }
+    }
+
+    ei_free(hist);
+    return success;
+}
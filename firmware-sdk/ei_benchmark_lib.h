@@ -0,0 +1,84 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_BENCHMARK_LIB_H
+#define EI_BENCHMARK_LIB_H
+
+#include <cstdint>
+#include <cstddef>
+#include "edge-impulse-sdk/dsp/numpy_types.h"
+
+/*
+ * Latency histogram with a fixed memory footprint. Values below 8 us get their
+ * own bucket, above that every power of two is split into 8 buckets, so a
+ * reported percentile is at most 12.5% above the real one. Values are kept up
+ * to 2^27 us (~134 s), longer ones are counted in an extra last bucket, which
+ * reports the maximum.
+ */
+#define EI_BENCH_HIST_SUB_BITS      3
+#define EI_BENCH_HIST_MAX_BITS      27
+#define EI_BENCH_HIST_BUCKETS       (((EI_BENCH_HIST_MAX_BITS - EI_BENCH_HIST_SUB_BITS + 1) << EI_BENCH_HIST_SUB_BITS) + 1)
+
+typedef struct {
+    uint32_t counts[EI_BENCH_HIST_BUCKETS];
+    uint32_t total;
+    uint64_t sum;
+    uint64_t max;
+} ei_bench_histogram_t;
+
+/* Function prototypes ----------------------------------------------------- */
+void ei_bench_hist_add(ei_bench_histogram_t *hist, uint64_t value_us);
+uint64_t ei_bench_hist_percentile(const ei_bench_histogram_t *hist, float percentile);
+
+/**
+ * @brief Print one line with mean, p50, p90, p99 and max of the histogram (in ms)
+ */
+void ei_bench_hist_print(const char *name, const ei_bench_histogram_t *hist);
+
+/**
+ * @brief Run the impulse iterations times on the same signal and print
+ * p50/p90/p99/max of DSP, classification, anomaly and postprocessing time
+ *
+ * Postprocessing is everything run_classifier spends outside of the DSP,
+ * classification and anomaly blocks. Heap peak comes from ei_memory_peak_use,
+ * which is only updated when EIDSP_TRACK_ALLOCATIONS is enabled.
+ *
+ * @param signal input signal, read again on every iteration
+ * @param iterations number of runs
+ * @return false if run_classifier failed, the user stopped the benchmark or
+ * the histograms couldn't be allocated
+ */
+bool ei_benchmark_impulse(ei::signal_t *signal, uint32_t iterations);
+
+#endif /* EI_BENCHMARK_LIB_H */
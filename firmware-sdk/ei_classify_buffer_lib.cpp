@@ -0,0 +1,761 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The recording is decoded with a small streaming CBOR parser instead of QCBOR. QCBOR decodes
+ * from a buffer holding the whole encoded recording, which would need as much RAM as the
+ * recording is long. Here the sample memory (flash) is read EI_CLASSIFY_BUFFER_CHUNK_SIZE
+ * bytes at a time and only the model window is kept, so any recording that fits the sample
+ * memory can be classified. Only ieee754.h is used from QCBOR, for half floats.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_classify_buffer_lib.h"
+#include "ei_device_lib.h"
+#include "model-parameters/model_metadata.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_types.h"
+#include "edge-impulse-sdk/dsp/numpy_types.h"
+#include <string.h>
+// ieee754.h has no C++ guards of its own
+extern "C" {
+#include "QCBOR/src/ieee754.h"
+}
+
+extern "C" EI_IMPULSE_ERROR run_classifier(
+    ei::signal_t *signal,
+    ei_impulse_result_t *result,
+    bool debug);
+
+/* Private constants ------------------------------------------------------- */
+#define CBOR_MAJOR_UINT         0
+#define CBOR_MAJOR_NINT         1
+#define CBOR_MAJOR_BYTES        2
+#define CBOR_MAJOR_TEXT         3
+#define CBOR_MAJOR_ARRAY        4
+#define CBOR_MAJOR_MAP          5
+#define CBOR_MAJOR_TAG          6
+#define CBOR_MAJOR_SIMPLE       7
+#define CBOR_INFO_HALF          25
+#define CBOR_INFO_FLOAT         26
+#define CBOR_INFO_DOUBLE        27
+#define CBOR_INFO_INDEFINITE    31
+
+/* the header is { protected: {..}, signature: "..", payload: { .., values: [..] } } */
+#define CBOR_MAX_DEPTH          4
+#define MAX_KEY_LENGTH          16
+#define MAX_AXIS_NAME_LENGTH    32
+#define MAX_RECORDING_AXES      16
+
+/* Private types ----------------------------------------------------------- */
+/* reads the recording sequentially, EI_CLASSIFY_BUFFER_CHUNK_SIZE bytes at a time */
+typedef struct {
+    EiDeviceMemory *mem;
+    uint8_t *chunk;
+    uint32_t chunk_pos;
+    uint32_t chunk_len;
+    uint32_t address;       // next address to read from the memory
+    uint32_t end;           // end of the recording
+    bool failed;            // reading the memory failed (as opposed to reaching the end)
+    uint64_t read_us;
+} chunk_reader_t;
+
+typedef struct {
+    uint8_t major;
+    uint8_t info;           // CBOR_INFO_INDEFINITE for indefinite lengths and break
+    uint64_t value;         // length, integer or float bits
+} cbor_head_t;
+
+typedef struct {
+    float interval_ms;
+    size_t axes;                                        // values per frame in the recording
+    int axis_map[EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME];  // recording axis of every model axis
+    bool values_indefinite;
+    uint64_t values_left;                               // frames left if values has a length
+} recording_t;
+
+typedef enum {
+    FIND_ERROR = -1,
+    FIND_NOT_FOUND = 0,
+    FIND_FOUND = 1
+} find_result_t;
+
+/* Private variables ------------------------------------------------------- */
+/* model window, frame after frame, the oldest frame is at window_oldest */
+static float *window;
+static size_t window_oldest;
+
+/* Private functions ------------------------------------------------------- */
+static bool reader_get(chunk_reader_t *reader, uint8_t *byte)
+{
+    if (reader->chunk_pos == reader->chunk_len) {
+        if (reader->address >= reader->end) {
+            return false;
+        }
+
+        uint32_t len = reader->end - reader->address;
+        if (len > EI_CLASSIFY_BUFFER_CHUNK_SIZE) {
+            len = EI_CLASSIFY_BUFFER_CHUNK_SIZE;
+        }
+
+        uint64_t start_us = ei_read_timer_us();
+        if (reader->mem->read_sample_data(reader->chunk, reader->address, len) != len) {
+            reader->failed = true;
+            return false;
+        }
+        reader->read_us += ei_read_timer_us() - start_us;
+
+        reader->address += len;
+        reader->chunk_pos = 0;
+        reader->chunk_len = len;
+    }
+
+    *byte = reader->chunk[reader->chunk_pos++];
+    return true;
+}
+
+static bool reader_skip(chunk_reader_t *reader, uint64_t bytes)
+{
+    uint8_t byte;
+
+    while (bytes > 0) {
+        // skip what is left of the chunk at once, reader_get loads the next one
+        uint32_t available = reader->chunk_len - reader->chunk_pos;
+        if (available == 0) {
+            if (!reader_get(reader, &byte)) {
+                return false;
+            }
+            bytes--;
+            continue;
+        }
+
+        uint32_t n = bytes < available ? (uint32_t)bytes : available;
+        reader->chunk_pos += n;
+        bytes -= n;
+    }
+
+    return true;
+}
+
+static bool cbor_read_head(chunk_reader_t *reader, cbor_head_t *head)
+{
+    uint8_t initial;
+
+    if (!reader_get(reader, &initial)) {
+        return false;
+    }
+
+    head->major = initial >> 5;
+    head->info = initial & 0x1f;
+    head->value = head->info;
+
+    if (head->info >= 24 && head->info <= 27) {
+        head->value = 0;
+        for (size_t ix = 0; ix < (1u << (head->info - 24)); ix++) {
+            uint8_t byte;
+            if (!reader_get(reader, &byte)) {
+                return false;
+            }
+            head->value = (head->value << 8) | byte;
+        }
+    }
+    else if (head->info > 27 && head->info != CBOR_INFO_INDEFINITE) {
+        return false;
+    }
+
+    return true;
+}
+
+static bool cbor_is_break(const cbor_head_t *head)
+{
+    return head->major == CBOR_MAJOR_SIMPLE && head->info == CBOR_INFO_INDEFINITE;
+}
+
+/**
+ * @brief Read the head of the next item of an array or map
+ * @return false at the end of the container (count reached or break) or on error
+ */
+static bool cbor_next_in(chunk_reader_t *reader, const cbor_head_t *container, uint64_t *left, cbor_head_t *head)
+{
+    if (container->info != CBOR_INFO_INDEFINITE && *left == 0) {
+        return false;
+    }
+    if (!cbor_read_head(reader, head) || cbor_is_break(head)) {
+        return false;
+    }
+
+    (*left)--;
+    return true;
+}
+
+static bool cbor_skip(chunk_reader_t *reader, const cbor_head_t *head, int depth)
+{
+    cbor_head_t item;
+    uint64_t left;
+
+    if (depth > CBOR_MAX_DEPTH) {
+        return false;
+    }
+
+    switch (head->major) {
+        case CBOR_MAJOR_UINT:
+        case CBOR_MAJOR_NINT:
+        case CBOR_MAJOR_SIMPLE:
+            return !cbor_is_break(head);
+        case CBOR_MAJOR_BYTES:
+        case CBOR_MAJOR_TEXT:
+            if (head->info != CBOR_INFO_INDEFINITE) {
+                return reader_skip(reader, head->value);
+            }
+            // definite length chunks until break
+            while (cbor_read_head(reader, &item)) {
+                if (cbor_is_break(&item)) {
+                    return true;
+                }
+                if (item.major != head->major || !reader_skip(reader, item.value)) {
+                    return false;
+                }
+            }
+            return false;
+        case CBOR_MAJOR_ARRAY:
+        case CBOR_MAJOR_MAP:
+            left = head->major == CBOR_MAJOR_MAP ? head->value * 2 : head->value;
+            while (head->info == CBOR_INFO_INDEFINITE || left > 0) {
+                if (!cbor_read_head(reader, &item)) {
+                    return false;
+                }
+                if (cbor_is_break(&item)) {
+                    return head->info == CBOR_INFO_INDEFINITE;
+                }
+                if (!cbor_skip(reader, &item, depth + 1)) {
+                    return false;
+                }
+                left--;
+            }
+            return true;
+        case CBOR_MAJOR_TAG:
+            return cbor_read_head(reader, &item) && cbor_skip(reader, &item, depth + 1);
+        default:
+            return false;
+    }
+}
+
+static bool cbor_to_float(const cbor_head_t *head, float *value)
+{
+    switch (head->major) {
+        case CBOR_MAJOR_UINT:
+            *value = (float)head->value;
+            return true;
+        case CBOR_MAJOR_NINT:
+            *value = -1.0f - (float)head->value;
+            return true;
+        case CBOR_MAJOR_SIMPLE:
+            if (head->info == CBOR_INFO_HALF) {
+                *value = IEEE754_HalfToFloat((uint16_t)head->value);
+                return true;
+            }
+            else if (head->info == CBOR_INFO_FLOAT) {
+                uint32_t bits = (uint32_t)head->value;
+                memcpy(value, &bits, sizeof(bits));
+                return true;
+            }
+            else if (head->info == CBOR_INFO_DOUBLE) {
+                double d;
+                memcpy(&d, &head->value, sizeof(d));
+                *value = (float)d;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Read a text string into str (truncated to size - 1), other items are skipped
+ */
+static bool cbor_read_text(chunk_reader_t *reader, const cbor_head_t *head, char *str, size_t size)
+{
+    str[0] = '\0';
+
+    if (head->major != CBOR_MAJOR_TEXT || head->info == CBOR_INFO_INDEFINITE) {
+        return cbor_skip(reader, head, 0);
+    }
+
+    size_t len = 0;
+    for (uint64_t ix = 0; ix < head->value; ix++) {
+        uint8_t byte;
+        if (!reader_get(reader, &byte)) {
+            return false;
+        }
+        if (len < size - 1) {
+            str[len++] = (char)byte;
+        }
+    }
+    str[len] = '\0';
+
+    return true;
+}
+
+/**
+ * @brief Name of model axis ix, from EI_CLASSIFIER_FUSION_AXES_STRING ("accX + accY + accZ")
+ */
+static bool get_model_axis_name(size_t ix, char *name, size_t size)
+{
+#ifdef EI_CLASSIFIER_FUSION_AXES_STRING
+    const char *axes = EI_CLASSIFIER_FUSION_AXES_STRING;
+
+    for (size_t axis = 0; axis < ix; axis++) {
+        axes = strchr(axes, '+');
+        if (axes == nullptr) {
+            return false;
+        }
+        axes++;
+    }
+
+    while (*axes == ' ') {
+        axes++;
+    }
+
+    size_t len = 0;
+    while (axes[len] != '\0' && axes[len] != '+' && len < size - 1) {
+        name[len] = axes[len];
+        len++;
+    }
+    while (len > 0 && name[len - 1] == ' ') {
+        len--;
+    }
+    name[len] = '\0';
+
+    return len > 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Parse the "sensors" array, match its names to the model axes
+ */
+static bool parse_sensors(chunk_reader_t *reader, const cbor_head_t *array, recording_t *recording)
+{
+    uint64_t sensors_left = array->value;
+    cbor_head_t sensor;
+
+    while (cbor_next_in(reader, array, &sensors_left, &sensor)) {
+        if (sensor.major != CBOR_MAJOR_MAP) {
+            return false;
+        }
+
+        uint64_t entries_left = sensor.value;
+        cbor_head_t key_head;
+        while (cbor_next_in(reader, &sensor, &entries_left, &key_head)) {
+            char key[MAX_KEY_LENGTH];
+            char name[MAX_AXIS_NAME_LENGTH];
+            cbor_head_t value;
+
+            if (!cbor_read_text(reader, &key_head, key, sizeof(key)) || !cbor_read_head(reader, &value)) {
+                return false;
+            }
+
+            if (strcmp(key, "name") != 0) {
+                if (!cbor_skip(reader, &value, 1)) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (!cbor_read_text(reader, &value, name, sizeof(name))) {
+                return false;
+            }
+            for (size_t ix = 0; ix < EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME; ix++) {
+                char model_name[MAX_AXIS_NAME_LENGTH];
+                if (recording->axis_map[ix] < 0 && get_model_axis_name(ix, model_name, sizeof(model_name))
+                    && strcmp(name, model_name) == 0) {
+                    recording->axis_map[ix] = (int)recording->axes;
+                    break;
+                }
+            }
+        }
+
+        recording->axes++;
+    }
+
+    return !reader->failed;
+}
+
+/**
+ * @brief Walk a map of the header until the "values" array, which is left open
+ * with the reader on its first frame
+ */
+static find_result_t find_values(chunk_reader_t *reader, const cbor_head_t *map, recording_t *recording, int depth)
+{
+    uint64_t entries_left = map->value;
+    cbor_head_t key_head;
+
+    if (depth > CBOR_MAX_DEPTH) {
+        return FIND_ERROR;
+    }
+
+    while (cbor_next_in(reader, map, &entries_left, &key_head)) {
+        char key[MAX_KEY_LENGTH];
+        cbor_head_t value;
+
+        if (!cbor_read_text(reader, &key_head, key, sizeof(key)) || !cbor_read_head(reader, &value)) {
+            return FIND_ERROR;
+        }
+
+        if (strcmp(key, "payload") == 0 && value.major == CBOR_MAJOR_MAP) {
+            find_result_t res = find_values(reader, &value, recording, depth + 1);
+            if (res != FIND_NOT_FOUND) {
+                return res;
+            }
+        }
+        else if (strcmp(key, "interval_ms") == 0) {
+            if (!cbor_to_float(&value, &recording->interval_ms)) {
+                return FIND_ERROR;
+            }
+        }
+        else if (strcmp(key, "sensors") == 0 && value.major == CBOR_MAJOR_ARRAY) {
+            if (!parse_sensors(reader, &value, recording)) {
+                return FIND_ERROR;
+            }
+        }
+        else if (strcmp(key, "values") == 0 && value.major == CBOR_MAJOR_ARRAY) {
+            recording->values_indefinite = value.info == CBOR_INFO_INDEFINITE;
+            recording->values_left = value.value;
+            return FIND_FOUND;
+        }
+        else if (!cbor_skip(reader, &value, depth + 1)) {
+            return FIND_ERROR;
+        }
+    }
+
+    return reader->failed ? FIND_ERROR : FIND_NOT_FOUND;
+}
+
+static bool parse_header(chunk_reader_t *reader, recording_t *recording)
+{
+    cbor_head_t map;
+
+    recording->interval_ms = 0.0f;
+    recording->axes = 0;
+    for (size_t ix = 0; ix < EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME; ix++) {
+        recording->axis_map[ix] = -1;
+    }
+
+    if (!cbor_read_head(reader, &map) || map.major != CBOR_MAJOR_MAP) {
+        ei_printf("ERR: No sample data found at this address\r\n");
+        return false;
+    }
+
+    if (find_values(reader, &map, recording, 0) != FIND_FOUND) {
+        ei_printf("ERR: Failed to parse the sample header\r\n");
+        return false;
+    }
+
+    if (recording->axes == 0 || recording->axes > MAX_RECORDING_AXES) {
+        ei_printf("ERR: Recording has %d axes, expected 1 to %d\r\n", (int)recording->axes, MAX_RECORDING_AXES);
+        return false;
+    }
+
+    // recordings of a single axis can be used for single axis models, whatever their name
+    if (recording->axes == 1 && EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME == 1) {
+        recording->axis_map[0] = 0;
+    }
+
+    for (size_t ix = 0; ix < EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME; ix++) {
+        if (recording->axis_map[ix] < 0) {
+            char model_name[MAX_AXIS_NAME_LENGTH];
+            if (!get_model_axis_name(ix, model_name, sizeof(model_name))) {
+                strcpy(model_name, "?");
+            }
+            ei_printf("ERR: Model axis %s is not in the recording\r\n", model_name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decode the next frame into the model axes order
+ * @return 1 if a frame was read, 0 at the end of the recording, -1 on error
+ */
+static int read_frame(chunk_reader_t *reader, recording_t *recording, float *frame)
+{
+    float values[MAX_RECORDING_AXES];
+    cbor_head_t head;
+
+    if (!recording->values_indefinite && recording->values_left == 0) {
+        return 0;
+    }
+    if (!cbor_read_head(reader, &head)) {
+        // a length that cuts the last frame ends the recording as well
+        return reader->failed ? -1 : 0;
+    }
+    if (cbor_is_break(&head)) {
+        return 0;
+    }
+    recording->values_left--;
+
+    if (head.major != CBOR_MAJOR_ARRAY) {
+        // single axis recordings are a flat array of values
+        if (recording->axes != 1 || !cbor_to_float(&head, &values[0])) {
+            return -1;
+        }
+    }
+    else {
+        if (head.info == CBOR_INFO_INDEFINITE || head.value != recording->axes) {
+            return -1;
+        }
+        for (size_t ix = 0; ix < recording->axes; ix++) {
+            cbor_head_t value;
+            if (!cbor_read_head(reader, &value)) {
+                return reader->failed ? -1 : 0;
+            }
+            if (!cbor_to_float(&value, &values[ix])) {
+                return -1;
+            }
+        }
+    }
+
+    for (size_t ix = 0; ix < EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME; ix++) {
+        frame[ix] = values[recording->axis_map[ix]];
+    }
+
+    return 1;
+}
+
+static int window_get_data(size_t offset, size_t length, float *out_ptr)
+{
+    const size_t size = EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE;
+    size_t pos = (window_oldest * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME + offset) % size;
+
+    while (length > 0) {
+        size_t n = length < size - pos ? length : size - pos;
+        memcpy(out_ptr, window + pos, n * sizeof(float));
+        out_ptr += n;
+        length -= n;
+        pos = 0;
+    }
+
+    return 0;
+}
+
+static void print_window_result(uint32_t window_ix, float start_ms, const ei_impulse_result_t *result)
+{
+    ei_printf("#%u %.0f ms:", (unsigned)window_ix, start_ms);
+#if EI_CLASSIFIER_OBJECT_DETECTION == 1
+    uint32_t boxes = 0;
+    for (uint32_t ix = 0; ix < EI_CLASSIFIER_OBJECT_DETECTION_COUNT; ix++) {
+        if (result->bounding_boxes[ix].value > 0) {
+            boxes++;
+        }
+    }
+    ei_printf(" %u boxes", (unsigned)boxes);
+#else
+    for (uint16_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+        ei_printf(" %s %.5f", result->classification[ix].label, result->classification[ix].value);
+    }
+#endif
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+    ei_printf(" anomaly %.3f", result->anomaly);
+#endif
+    ei_printf("\r\n");
+}
+
+/* Public functions -------------------------------------------------------- */
+bool ei_classify_buffer(
+    EiDeviceMemory *mem,
+    uint32_t start,
+    uint32_t length,
+    uint32_t stride,
+    bool print_windows)
+{
+    chunk_reader_t reader = { mem, nullptr, 0, 0, start, start + length, false, 0 };
+    recording_t recording;
+    bool success = true;
+
+    if (stride == 0) {
+        ei_printf("ERR: Stride has to be at least 1 frame\r\n");
+        return false;
+    }
+
+    reader.chunk = (uint8_t *)ei_malloc(EI_CLASSIFY_BUFFER_CHUNK_SIZE);
+    window = (float *)ei_malloc(EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE * sizeof(float));
+    if (reader.chunk == nullptr || window == nullptr) {
+        ei_printf("ERR: Memory allocation for the read buffers failed\r\n");
+        ei_free(reader.chunk);
+        ei_free(window);
+        window = nullptr;
+        return false;
+    }
+    window_oldest = 0;
+
+    uint64_t start_us = ei_read_timer_us();
+    uint64_t classify_us = 0;
+    uint64_t print_us = 0;
+    uint32_t frames = 0;
+    uint32_t windows = 0;
+    uint32_t next_window_end = EI_CLASSIFIER_RAW_SAMPLE_COUNT;
+#if EI_CLASSIFIER_OBJECT_DETECTION != 1
+    const char *labels[EI_CLASSIFIER_LABEL_COUNT] = { nullptr };
+    uint32_t top_count[EI_CLASSIFIER_LABEL_COUNT] = { 0 };
+    float score_sum[EI_CLASSIFIER_LABEL_COUNT] = { 0 };
+#endif
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+    float anomaly_sum = 0.0f;
+    float anomaly_max = 0.0f;
+#endif
+
+    if (!parse_header(&reader, &recording)) {
+        ei_free(reader.chunk);
+        ei_free(window);
+        window = nullptr;
+        return false;
+    }
+
+    if (recording.interval_ms <= 0.0f) {
+        recording.interval_ms = (float)EI_CLASSIFIER_INTERVAL_MS;
+    }
+    float interval_diff = recording.interval_ms - (float)EI_CLASSIFIER_INTERVAL_MS;
+    if (interval_diff > 0.01f * EI_CLASSIFIER_INTERVAL_MS || interval_diff < -0.01f * EI_CLASSIFIER_INTERVAL_MS) {
+        ei_printf("WARN: Recorded at %.3f ms interval, the model expects %.3f ms, frames are not resampled\r\n",
+            recording.interval_ms, (float)EI_CLASSIFIER_INTERVAL_MS);
+    }
+
+    ei_printf("Classifying %u bytes, %d axes, window %d frames, stride %u frames\r\n",
+        (unsigned)length, (int)recording.axes, EI_CLASSIFIER_RAW_SAMPLE_COUNT, (unsigned)stride);
+
+    while (true) {
+        int res = read_frame(&reader, &recording, &window[window_oldest * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME]);
+        if (res < 0) {
+            ei_printf("ERR: Failed to decode frame %u\r\n", (unsigned)frames);
+            success = false;
+            break;
+        }
+        if (res == 0) {
+            break;
+        }
+
+        window_oldest = (window_oldest + 1) % EI_CLASSIFIER_RAW_SAMPLE_COUNT;
+        frames++;
+
+        if (frames != next_window_end) {
+            continue;
+        }
+        next_window_end += stride;
+
+        ei::signal_t signal;
+        signal.total_length = EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE;
+        signal.get_data = &window_get_data;
+
+        ei_impulse_result_t result;
+        memset(&result, 0, sizeof(result));
+
+        uint64_t window_start_us = ei_read_timer_us();
+        EI_IMPULSE_ERROR ei_error = run_classifier(&signal, &result, false);
+        classify_us += ei_read_timer_us() - window_start_us;
+
+        if (ei_error != EI_IMPULSE_OK) {
+            ei_printf("ERR: Failed to run classifier (%d)\r\n", ei_error);
+            success = false;
+            break;
+        }
+
+        if (print_windows) {
+            // printing isn't decoding, keep it out of the decode time
+            uint64_t print_start_us = ei_read_timer_us();
+            print_window_result(windows, (frames - EI_CLASSIFIER_RAW_SAMPLE_COUNT) * recording.interval_ms, &result);
+            print_us += ei_read_timer_us() - print_start_us;
+        }
+
+#if EI_CLASSIFIER_OBJECT_DETECTION != 1
+        size_t top = 0;
+        for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+            labels[ix] = result.classification[ix].label;
+            score_sum[ix] += result.classification[ix].value;
+            if (result.classification[ix].value > result.classification[top].value) {
+                top = ix;
+            }
+        }
+        top_count[top]++;
+#endif
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+        anomaly_sum += result.anomaly;
+        if (windows == 0 || result.anomaly > anomaly_max) {
+            anomaly_max = result.anomaly;
+        }
+#endif
+        windows++;
+
+        if (ei_user_invoke_stop_lib()) {
+            ei_printf("Classification stopped by user\r\n");
+            success = false;
+            break;
+        }
+    }
+
+    uint64_t total_us = ei_read_timer_us() - start_us;
+
+    ei_printf("Frames: %u, windows: %u\r\n", (unsigned)frames, (unsigned)windows);
+#if EI_CLASSIFIER_OBJECT_DETECTION != 1
+    if (windows > 0) {
+        ei_printf("Top label (windows, mean score):\r\n");
+        for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+            ei_printf("  %s: %u, %.5f\r\n", labels[ix],
+                (unsigned)top_count[ix], score_sum[ix] / windows);
+        }
+    }
+#endif
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+    if (windows > 0) {
+        ei_printf("Anomaly: mean %.3f, max %.3f\r\n", anomaly_sum / windows, anomaly_max);
+    }
+#endif
+    uint64_t decode_us = total_us - classify_us - reader.read_us - print_us;
+    ei_printf("Time: read %.1f ms, decode %.1f ms, classification %.1f ms, printing %.1f ms\r\n",
+        reader.read_us / 1000.f, decode_us / 1000.f, classify_us / 1000.f, print_us / 1000.f);
+    if (total_us > 0) {
+        float seconds = total_us / 1000000.f;
+        ei_printf("Throughput: %.2f windows/s, %.2fx real time\r\n",
+            windows / seconds, (frames * recording.interval_ms / 1000.f) / seconds);
+    }
+
+    ei_free(reader.chunk);
+    ei_free(window);
+    window = nullptr;
+
+    return success;
+}
@@ -0,0 +1,75 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_CLASSIFY_BUFFER_LIB_H
+#define EI_CLASSIFY_BUFFER_LIB_H
+
+#include <cstdint>
+#include "ei_device_memory.h"
+
+/*
+ * Size of the chunks read from the sample memory. The recording is decoded
+ * straight from this buffer, so only one chunk and one model window of frames
+ * are kept in RAM, whatever the length of the recording.
+ */
+#ifndef EI_CLASSIFY_BUFFER_CHUNK_SIZE
+#define EI_CLASSIFY_BUFFER_CHUNK_SIZE   4096
+#endif
+
+/* Function prototypes ----------------------------------------------------- */
+/**
+ * @brief Run the impulse over a recording stored in the sample memory
+ *
+ * The recording is the CBOR written by ei_sampler_start_sampling (header,
+ * indefinite "values" array, break byte). Its axes are matched by name to the
+ * model axes. The model window slides over the frames, stride frames at a
+ * time, and the result of every window is printed, followed by a summary with
+ * the top label counts and the throughput in windows per second.
+ *
+ * @param mem sample memory holding the recording
+ * @param start address of the recording in the sample memory
+ * @param length length of the recording in bytes
+ * @param stride frames between windows
+ * @param print_windows print the result of every window, not only the summary
+ * @return false if the recording couldn't be decoded, run_classifier failed or
+ * the user stopped it
+ */
+bool ei_classify_buffer(
+    EiDeviceMemory *mem,
+    uint32_t start,
+    uint32_t length,
+    uint32_t stride,
+    bool print_windows);
+
+#endif /* EI_CLASSIFY_BUFFER_LIB_H */
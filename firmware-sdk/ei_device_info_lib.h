@@ -151,20 +151,21 @@ public:
 
         memset(buf, 0, sizeof(EiConfig));
 
-        strncpy(buf->wifi_ssid, wifi_ssid.c_str(), 128);
-        strncpy(buf->wifi_password, wifi_password.c_str(), 128);
+        // one byte less than the fields, so the zeroed buffer keeps them terminated
+        strncpy(buf->wifi_ssid, wifi_ssid.c_str(), sizeof(buf->wifi_ssid) - 1);
+        strncpy(buf->wifi_password, wifi_password.c_str(), sizeof(buf->wifi_password) - 1);
         buf->wifi_security = wifi_security;
         buf->sample_interval_ms = sample_interval_ms;
         buf->sample_length_ms = sample_length_ms;
         buf->long_recording_interval_ms = long_recording_interval_ms;
         buf->long_recording_length_ms = long_recording_length_ms;
-        strncpy(buf->sample_label, sample_label.c_str(), 128);
-        strncpy(buf->sample_hmac_key, sample_hmac_key.c_str(), 33);
-        strncpy(buf->sensor_label, sensor_label.c_str(), 128);
-        strncpy(buf->upload_host, upload_host.c_str(), 128);
-        strncpy(buf->upload_path, upload_path.c_str(), 128);
-        strncpy(buf->upload_api_key, upload_api_key.c_str(), 128);
-        strncpy(buf->mgmt_url, management_url.c_str(), 128);
+        strncpy(buf->sample_label, sample_label.c_str(), sizeof(buf->sample_label) - 1);
+        strncpy(buf->sample_hmac_key, sample_hmac_key.c_str(), sizeof(buf->sample_hmac_key) - 1);
+        strncpy(buf->sensor_label, sensor_label.c_str(), sizeof(buf->sensor_label) - 1);
+        strncpy(buf->upload_host, upload_host.c_str(), sizeof(buf->upload_host) - 1);
+        strncpy(buf->upload_path, upload_path.c_str(), sizeof(buf->upload_path) - 1);
+        strncpy(buf->upload_api_key, upload_api_key.c_str(), sizeof(buf->upload_api_key) - 1);
+        strncpy(buf->mgmt_url, management_url.c_str(), sizeof(buf->mgmt_url) - 1);
         buf->magic = 0xdeadbeef;
 
         bool ret = memory->save_config((uint8_t *)buf, sizeof(EiConfig));
@@ -185,18 +186,18 @@ public:
         memory->load_config((uint8_t *)buf, sizeof(EiConfig));
 
         if (buf->magic == 0xdeadbeef) {
-            wifi_ssid = std::string(buf->wifi_ssid, 128);
-            wifi_password = std::string(buf->wifi_password, 128);
+            wifi_ssid = std::string(buf->wifi_ssid, sizeof(buf->wifi_ssid));
+            wifi_password = std::string(buf->wifi_password, sizeof(buf->wifi_password));
             wifi_security = buf->wifi_security;
             sample_interval_ms = buf->sample_interval_ms;
             sample_length_ms = buf->sample_length_ms;
-            sample_label = std::string(buf->sample_label, 128);
-            sample_hmac_key = std::string(buf->sample_hmac_key, 33);
-            upload_host = std::string(buf->upload_host, 128);
-            upload_path = std::string(buf->upload_path, 128);
-            upload_api_key = std::string(buf->upload_api_key, 128);
-            management_url = std::string(buf->mgmt_url, 128);
-            sensor_label = std::string(buf->sensor_label, 128);
+            sample_label = std::string(buf->sample_label, sizeof(buf->sample_label));
+            sample_hmac_key = std::string(buf->sample_hmac_key, sizeof(buf->sample_hmac_key));
+            upload_host = std::string(buf->upload_host, sizeof(buf->upload_host));
+            upload_path = std::string(buf->upload_path, sizeof(buf->upload_path));
+            upload_api_key = std::string(buf->upload_api_key, sizeof(buf->upload_api_key));
+            management_url = std::string(buf->mgmt_url, sizeof(buf->mgmt_url));
+            sensor_label = std::string(buf->sensor_label, sizeof(buf->sensor_label));
             long_recording_interval_ms = buf->long_recording_interval_ms;
             long_recording_length_ms = buf->long_recording_length_ms;
         }
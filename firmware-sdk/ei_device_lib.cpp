@@ -37,6 +37,7 @@
 #include "ei_device_info_lib.h"
 #include "ei_device_memory.h"
 #include "ei_device_interface.h"
+#include "ei_benchmark_lib.h"
 
 #include "edge-impulse-sdk/classifier/ei_classifier_types.h"
 #include "edge-impulse-sdk/classifier/ei_signal_with_axes.h"
@@ -49,6 +50,17 @@ extern "C" EI_IMPULSE_ERROR run_classifier(
 float *features;
 extern char* ei_classifier_inferencing_categories[];
 
+// last window received by run_impulse_static_data, kept for run_impulse_benchmark
+static float *static_data = NULL;
+static size_t static_data_size = 0;
+
+static void release_static_data(void)
+{
+    ei_free(static_data);
+    static_data = NULL;
+    static_data_size = 0;
+}
+
 /**
  * @brief      Call this function periocally during inference to
  *             detect a user stop command
@@ -122,6 +134,8 @@ bool run_impulse_static_data(bool debug, size_t length, size_t buf_len)
         return false;
     }
 
+    release_static_data();
+
     data_pt = (float*)ei_malloc(length*sizeof(float));
     if (data_pt == NULL) {
         ei_printf("ERR: Memory allocation for data buffer failed\r\n");
@@ -172,8 +186,9 @@ bool run_impulse_static_data(bool debug, size_t length, size_t buf_len)
 
     ei_printf("TRANSFER COMPLETED %d\r\n", (int)cur_pos);
     uint32_t res = (uint32_t)ei_start_impulse_static_data(debug, data_pt, cur_pos);
+    static_data = data_pt;
+    static_data_size = cur_pos;
     cur_pos = 0;
-    ei_free(data_pt);
     ei_free(temp_buf);
     data_pt = NULL;
     temp_buf = NULL;
@@ -183,12 +198,62 @@ bool run_impulse_static_data(bool debug, size_t length, size_t buf_len)
     return true;
 }
 
+bool run_impulse_static_data_framed(bool debug, size_t length, const ei_frame_io_t *io)
+{
+    release_static_data();
+
+    float *data_pt = (float*)ei_malloc(length*sizeof(float));
+    if (data_pt == NULL) {
+        ei_printf("ERR: Memory allocation for data buffer failed\r\n");
+        return false;
+    }
+
+    ei_printf("OK FRAMED CHUNK=%d WINDOW=%d\r\n", EI_FRAME_MAX_PAYLOAD, EI_FRAME_WINDOW);
+
+    if (!ei_frame_receive(io, (uint8_t*)data_pt, length*sizeof(float))) {
+        ei_printf("TIMEOUT\r\n");
+        ei_free(data_pt);
+        ei_printf("END OUTPUT\r\n");
+        return false;
+    }
+
+    ei_printf("TRANSFER COMPLETED %d\r\n", (int)length);
+    uint32_t res = (uint32_t)ei_start_impulse_static_data(debug, data_pt, length);
+    static_data = data_pt;
+    static_data_size = length;
+    ei_printf("RESULT %d\r\n", res);
+    ei_printf("END OUTPUT\r\n");
+
+    return true;
+}
+
 int raw_feature_get_data(size_t offset, size_t length, float *out_ptr)
 {
     memcpy(out_ptr, features + offset, length * sizeof(float));
     return 0;
 }
 
+bool run_impulse_benchmark(uint32_t iterations)
+{
+    if (static_data == NULL) {
+        ei_printf("ERR: No static data loaded, run AT+RUNIMPULSESTATIC first\r\n");
+        return false;
+    }
+
+    if (static_data_size != EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE) {
+        ei_printf("ERR: Static data has %d items, expected %d\r\n",
+                (int)static_data_size, EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
+        return false;
+    }
+
+    signal_t signal;
+    features = static_data;
+    signal.total_length = static_data_size;
+    signal.get_data = &raw_feature_get_data;
+
+    return ei_benchmark_impulse(&signal, iterations);
+}
+
 EI_IMPULSE_ERROR ei_start_impulse_static_data(bool debug, float* data, size_t size) {
 
     features = data;
@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <cstddef>
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "ei_frame_lib.h"
 
 /**
  * @brief      Call this function periocally during inference to
@@ -60,6 +61,26 @@ bool read_encode_send_sample_buffer(size_t address, size_t length);
 
 bool run_impulse_static_data(bool debug, size_t length, size_t buf_len);
 
+/**
+ * @brief Same as run_impulse_static_data, but the features are received as
+ * binary frames (see ei_frame_lib.h) instead of base64 chunks
+ *
+ * @param debug run the classifier in debug mode
+ * @param length number of features (floats)
+ * @param io serial port access
+ * @return false if the transfer failed
+ */
+bool run_impulse_static_data_framed(bool debug, size_t length, const ei_frame_io_t *io);
+
 EI_IMPULSE_ERROR ei_start_impulse_static_data(bool debug, float* data, size_t size);
 
+/**
+ * @brief Rerun the impulse on the window last received by run_impulse_static_data
+ * and print timing histograms (see ei_benchmark_lib.h)
+ *
+ * @param iterations number of runs
+ * @return false if there is no static data or the benchmark failed
+ */
+bool run_impulse_benchmark(uint32_t iterations);
+
 #endif /* EI_DEVICE_LIB_H */
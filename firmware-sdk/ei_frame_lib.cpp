@@ -0,0 +1,345 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_frame_lib.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include <string.h>
+
+/* Private types ----------------------------------------------------------- */
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    const uint8_t *payload;
+    size_t length;
+} frame_t;
+
+typedef struct {
+    uint8_t encoded[EI_FRAME_ENCODED_MAX];
+    uint8_t raw[EI_FRAME_RAW_MAX];
+    size_t length;
+    bool overflow;
+} frame_parser_t;
+
+/* Private variables ------------------------------------------------------- */
+static const uint32_t crc32_table[16] = {
+    0x00000000u, 0x1db71064u, 0x3b6e20c8u, 0x26d930acu, 0x76dc4190u, 0x6b6b51f4u, 0x4db26158u, 0x5005713cu,
+    0xedb88320u, 0xf00f9344u, 0xd6d6a3e8u, 0xcb61b38cu, 0x9b64c2b0u, 0x86d3d2d4u, 0xa00ae278u, 0xbdbdf21cu
+};
+
+/* Private functions ------------------------------------------------------- */
+static void frame_write(const ei_frame_io_t *io, uint8_t type, uint8_t seq, const uint8_t *payload, size_t length)
+{
+    uint8_t raw[EI_FRAME_RAW_MAX];
+    uint8_t encoded[EI_FRAME_ENCODED_MAX + 1];
+
+    raw[0] = type;
+    raw[1] = seq;
+    if (length > 0) {
+        memcpy(&raw[EI_FRAME_HEADER_SIZE], payload, length);
+    }
+    length += EI_FRAME_HEADER_SIZE;
+
+    uint32_t crc = ei_crc32(raw, length);
+    raw[length++] = (uint8_t)crc;
+    raw[length++] = (uint8_t)(crc >> 8);
+    raw[length++] = (uint8_t)(crc >> 16);
+    raw[length++] = (uint8_t)(crc >> 24);
+
+    size_t encoded_length = ei_cobs_encode(raw, length, encoded);
+    encoded[encoded_length++] = 0x00;
+    io->write(encoded, encoded_length);
+}
+
+/**
+ * @brief Consume received bytes until a frame is complete
+ *
+ * @return 1 if a valid frame was received, -1 if a corrupted one was dropped,
+ * 0 if no complete frame is available yet
+ */
+static int frame_poll(const ei_frame_io_t *io, frame_parser_t *parser, frame_t *frame)
+{
+    uint8_t byte;
+
+    while (io->read(&byte, 1) == 1) {
+        if (byte != 0x00) {
+            if (parser->length < sizeof(parser->encoded)) {
+                parser->encoded[parser->length++] = byte;
+            }
+            else {
+                parser->overflow = true;
+            }
+            continue;
+        }
+
+        size_t encoded_length = parser->length;
+        bool overflow = parser->overflow;
+        parser->length = 0;
+        parser->overflow = false;
+
+        if (encoded_length == 0) {
+            // empty frame, i.e. the delimiter starting a transfer
+            continue;
+        }
+        if (overflow) {
+            return -1;
+        }
+
+        size_t length = ei_cobs_decode(parser->encoded, encoded_length, parser->raw);
+        if (length < EI_FRAME_HEADER_SIZE + EI_FRAME_CRC_SIZE) {
+            return -1;
+        }
+
+        length -= EI_FRAME_CRC_SIZE;
+        const uint8_t *crc_bytes = &parser->raw[length];
+        uint32_t crc = (uint32_t)crc_bytes[0] | ((uint32_t)crc_bytes[1] << 8) |
+                       ((uint32_t)crc_bytes[2] << 16) | ((uint32_t)crc_bytes[3] << 24);
+        if (ei_crc32(parser->raw, length) != crc) {
+            return -1;
+        }
+
+        frame->type = parser->raw[0];
+        frame->seq = parser->raw[1];
+        frame->payload = &parser->raw[EI_FRAME_HEADER_SIZE];
+        frame->length = length - EI_FRAME_HEADER_SIZE;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void frame_flush(const ei_frame_io_t *io)
+{
+    if (io->flush) {
+        io->flush();
+    }
+}
+
+/* Public functions -------------------------------------------------------- */
+uint32_t ei_crc32(const uint8_t *data, size_t length, uint32_t crc)
+{
+    crc = ~crc;
+    while (length--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ crc32_table[crc & 0x0f];
+        crc = (crc >> 4) ^ crc32_table[crc & 0x0f];
+    }
+    return ~crc;
+}
+
+size_t ei_cobs_encode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t code_ix = 0;
+    size_t out_ix = 1;
+    uint8_t code = 1;
+
+    for (size_t ix = 0; ix < length; ix++) {
+        if (input[ix] != 0x00) {
+            output[out_ix++] = input[ix];
+            code++;
+        }
+        if (input[ix] == 0x00 || code == 0xff) {
+            output[code_ix] = code;
+            code = 1;
+            code_ix = out_ix++;
+        }
+    }
+    output[code_ix] = code;
+
+    return out_ix;
+}
+
+size_t ei_cobs_decode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t in_ix = 0;
+    size_t out_ix = 0;
+
+    while (in_ix < length) {
+        uint8_t code = input[in_ix++];
+        if (code == 0x00 || in_ix + code - 1 > length) {
+            return 0;
+        }
+        for (uint8_t ix = 1; ix < code; ix++) {
+            output[out_ix++] = input[in_ix++];
+        }
+        if (code != 0xff && in_ix < length) {
+            output[out_ix++] = 0x00;
+        }
+    }
+
+    return out_ix;
+}
+
+bool ei_frame_send(const ei_frame_io_t *io, size_t length, ei_frame_source_t source, void *ctx)
+{
+    uint8_t payload[EI_FRAME_MAX_PAYLOAD];
+    frame_parser_t parser = { };
+    frame_t frame;
+    const size_t frames_total = (length + EI_FRAME_MAX_PAYLOAD - 1) / EI_FRAME_MAX_PAYLOAD;
+    size_t base = 0;    // first frame not acknowledged yet
+    size_t next = 0;    // next frame to (re)transmit
+    int retries = 0;
+    uint64_t last_progress = ei_read_timer_ms();
+
+    const uint8_t start = 0x00;
+    io->write(&start, 1);
+
+    while (base < frames_total) {
+        while (next < frames_total && next - base < EI_FRAME_WINDOW) {
+            size_t offset = next * EI_FRAME_MAX_PAYLOAD;
+            size_t chunk = length - offset < EI_FRAME_MAX_PAYLOAD ? length - offset : EI_FRAME_MAX_PAYLOAD;
+
+            if (!source(ctx, offset, payload, chunk)) {
+                frame_flush(io);
+                return false;
+            }
+            frame_write(io, EI_FRAME_DATA, (uint8_t)next, payload, chunk);
+            next++;
+        }
+
+        if (frame_poll(io, &parser, &frame) == 1 &&
+            (frame.type == EI_FRAME_ACK || frame.type == EI_FRAME_NAK)) {
+            // seq is the next frame the receiver expects, only [base, next] are valid
+            size_t acked = base + (uint8_t)(frame.seq - (uint8_t)base);
+            if (acked > next) {
+                continue;
+            }
+            if (acked > base) {
+                base = acked;
+                retries = 0;
+                last_progress = ei_read_timer_ms();
+            }
+            if (frame.type == EI_FRAME_NAK) {
+                next = base;
+            }
+            continue;
+        }
+
+        if (ei_read_timer_ms() - last_progress > EI_FRAME_TIMEOUT_MS) {
+            if (++retries > EI_FRAME_MAX_RETRIES) {
+                frame_flush(io);
+                return false;
+            }
+            next = base;
+            last_progress = ei_read_timer_ms();
+        }
+    }
+
+    frame_flush(io);
+    return true;
+}
+
+bool ei_frame_receive(const ei_frame_io_t *io, uint8_t *output, size_t length)
+{
+    frame_parser_t parser = { };
+    frame_t frame;
+    size_t expected = 0;    // index of the next frame to accept
+    size_t offset = 0;
+    int since_ack = 0;
+    int retries = 0;
+    bool nak_sent = false;
+    uint64_t last_progress = ei_read_timer_ms();
+
+    const uint8_t start = 0x00;
+    io->write(&start, 1);
+
+    while (offset < length) {
+        int res = frame_poll(io, &parser, &frame);
+
+        if (res == 1 && frame.type == EI_FRAME_DATA) {
+            size_t remaining = length - offset;
+            bool length_ok = frame.length == EI_FRAME_MAX_PAYLOAD ||
+                             frame.length == remaining;
+
+            if (frame.seq == (uint8_t)expected && length_ok && frame.length <= remaining) {
+                memcpy(&output[offset], frame.payload, frame.length);
+                offset += frame.length;
+                expected++;
+                retries = 0;
+                nak_sent = false;
+                last_progress = ei_read_timer_ms();
+
+                if (offset == length) {
+                    // nothing acknowledges the final ACK, send it a few times
+                    for (int ix = 0; ix < EI_FRAME_FINAL_ACKS; ix++) {
+                        frame_write(io, EI_FRAME_ACK, (uint8_t)expected, nullptr, 0);
+                    }
+                }
+                else if (++since_ack >= (EI_FRAME_WINDOW + 1) / 2) {
+                    frame_write(io, EI_FRAME_ACK, (uint8_t)expected, nullptr, 0);
+                    since_ack = 0;
+                }
+            }
+            else if ((uint8_t)(expected - frame.seq) != 0 &&
+                     (uint8_t)(expected - frame.seq) <= EI_FRAME_WINDOW) {
+                // retransmission of a frame we already have, our ACK got lost
+                frame_write(io, EI_FRAME_ACK, (uint8_t)expected, nullptr, 0);
+            }
+            else if (!nak_sent) {
+                frame_write(io, EI_FRAME_NAK, (uint8_t)expected, nullptr, 0);
+                nak_sent = true;
+            }
+        }
+        else if (res == -1 && !nak_sent) {
+            frame_write(io, EI_FRAME_NAK, (uint8_t)expected, nullptr, 0);
+            nak_sent = true;
+        }
+        else if (res == 0 && ei_read_timer_ms() - last_progress > EI_FRAME_TIMEOUT_MS) {
+            if (++retries > EI_FRAME_MAX_RETRIES) {
+                frame_flush(io);
+                return false;
+            }
+            // nudge the sender in case our last ACK got lost
+            frame_write(io, EI_FRAME_ACK, (uint8_t)expected, nullptr, 0);
+            nak_sent = false;
+            last_progress = ei_read_timer_ms();
+        }
+    }
+
+    // the final ACKs may still get lost, keep answering retransmissions for a while. The
+    // sender retransmits after EI_FRAME_TIMEOUT_MS without progress, so wait for two of them
+    last_progress = ei_read_timer_ms();
+    while (ei_read_timer_ms() - last_progress < 2 * EI_FRAME_TIMEOUT_MS + EI_FRAME_TIMEOUT_MS / 2) {
+        int res = frame_poll(io, &parser, &frame);
+        if (res != 0) {
+            if (res == 1 && frame.type == EI_FRAME_DATA) {
+                frame_write(io, EI_FRAME_ACK, (uint8_t)expected, nullptr, 0);
+            }
+            last_progress = ei_read_timer_ms();
+        }
+    }
+
+    frame_flush(io);
+    return true;
+}
@@ -0,0 +1,139 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_FRAME_LIB_H
+#define EI_FRAME_LIB_H
+
+/*
+ * Binary framed serial transfer, an opt-in alternative to base64 text for bulk
+ * transfers (AT+READBUFFER, AT+RUNIMPULSESTATIC).
+ *
+ * Every frame is COBS encoded and terminated with a 0x00 byte. Before encoding
+ * a frame looks like this:
+ *
+ *   | type (1) | seq (1) | payload (0..EI_FRAME_MAX_PAYLOAD) | CRC32 (4, LE) |
+ *
+ * The CRC32 (IEEE 802.3) covers type, seq and payload. DATA frames carry
+ * EI_FRAME_MAX_PAYLOAD bytes each (the last one may be shorter), seq is the
+ * frame index modulo 256. Flow control is go-back-N with a window of
+ * EI_FRAME_WINDOW frames: the receiver acknowledges with ACK frames carrying the
+ * seq of the next frame it expects (cumulative), and answers a corrupted or
+ * out-of-order frame with a NAK carrying the same. The sender resends from the
+ * first unacknowledged frame on NAK or when no progress is made for
+ * EI_FRAME_TIMEOUT_MS. Transfers start with a lone 0x00 so that any text
+ * preceding the first frame is discarded. The last DATA frame is acknowledged
+ * EI_FRAME_FINAL_ACKS times, and the receiver keeps answering retransmissions
+ * until it has seen none for 2.5 * EI_FRAME_TIMEOUT_MS.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+
+#ifndef EI_FRAME_MAX_PAYLOAD
+#define EI_FRAME_MAX_PAYLOAD    240
+#endif
+
+#ifndef EI_FRAME_WINDOW
+#define EI_FRAME_WINDOW         4
+#endif
+
+#ifndef EI_FRAME_TIMEOUT_MS
+#define EI_FRAME_TIMEOUT_MS     500
+#endif
+
+#ifndef EI_FRAME_MAX_RETRIES
+#define EI_FRAME_MAX_RETRIES    10
+#endif
+
+#ifndef EI_FRAME_FINAL_ACKS
+#define EI_FRAME_FINAL_ACKS     3
+#endif
+
+#define EI_FRAME_HEADER_SIZE    2
+#define EI_FRAME_CRC_SIZE       4
+#define EI_FRAME_RAW_MAX        (EI_FRAME_HEADER_SIZE + EI_FRAME_MAX_PAYLOAD + EI_FRAME_CRC_SIZE)
+/* COBS adds one byte per started 254 byte block */
+#define EI_FRAME_ENCODED_MAX    (EI_FRAME_RAW_MAX + (EI_FRAME_RAW_MAX / 254) + 1)
+
+typedef enum {
+    EI_FRAME_DATA = 0x01,
+    EI_FRAME_ACK = 0x02,
+    EI_FRAME_NAK = 0x03
+} ei_frame_type_t;
+
+/**
+ * @brief Serial port access used by the framed transfers
+ */
+typedef struct {
+    /* queue data for sending */
+    void (*write)(const uint8_t *data, size_t length);
+    /* read received data without blocking, returns number of bytes read */
+    size_t (*read)(uint8_t *data, size_t length);
+    /* wait until all written data is sent, may be NULL */
+    void (*flush)(void);
+} ei_frame_io_t;
+
+/**
+ * @brief Provides length bytes of the transferred data starting at offset
+ * @return false if the data couldn't be read
+ */
+typedef bool (*ei_frame_source_t)(void *ctx, size_t offset, uint8_t *data, size_t length);
+
+/* Function prototypes ----------------------------------------------------- */
+uint32_t ei_crc32(const uint8_t *data, size_t length, uint32_t crc = 0);
+size_t ei_cobs_encode(const uint8_t *input, size_t length, uint8_t *output);
+size_t ei_cobs_decode(const uint8_t *input, size_t length, uint8_t *output);
+
+/**
+ * @brief Send length bytes as DATA frames, returns once all of them are acknowledged
+ *
+ * @param io serial port access
+ * @param length number of bytes to send
+ * @param source called for every (re)transmitted frame to get its payload
+ * @param ctx passed to source
+ * @return false if source failed or the receiver stopped responding
+ */
+bool ei_frame_send(const ei_frame_io_t *io, size_t length, ei_frame_source_t source, void *ctx);
+
+/**
+ * @brief Receive exactly length bytes sent as DATA frames
+ *
+ * @param io serial port access
+ * @param output buffer for the received data
+ * @param length number of bytes to receive
+ * @return false if the sender stopped sending
+ */
+bool ei_frame_receive(const ei_frame_io_t *io, uint8_t *output, size_t length);
+
+#endif /* EI_FRAME_LIB_H */
@@ -37,6 +37,7 @@
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "ei_device_info_lib.h"
 #include "ei_sampler.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include <iomanip>
 #include <math.h>
 #include <stdint.h>
@@ -67,6 +68,17 @@ vector<fused_sensors_t> fused_sensors;
 */
 static vector<ei_device_fusion_sensor_t *> fusion_sensors;
 int num_fusions, num_fusion_axis;
+/*
+** @brief gather table built from the fusion list, fusion_axis_map[fusion_axis_start[i]..fusion_axis_start[i+1]]
+** holds indexes of axes used from the fusion_sensors[i] data
+*/
+static uint8_t fusion_axis_map[EI_MAX_SENSOR_AXES];
+static uint8_t fusion_axis_start[NUM_MAX_FUSIONS + 1];
+/*
+** @brief frame passed to the sampler callback, for multi frequency sampling it also keeps
+** the last values of sensors not sampled in the current period
+*/
+static fusion_sample_format_t fusion_frame[EI_MAX_SENSOR_AXES];
 #if MULTI_FREQ_ENABLED == 1
 #define MULTI_FREQ_MAX_FREQ_NOT_SET     (-1.0f)
 
@@ -76,7 +88,6 @@ int num_fusions, num_fusion_axis;
 
 static float multi_sampling_freq[NUM_MAX_FUSIONS];
 static float multi_freq_combination[NUM_MAX_FUSIONS][EI_MAX_FREQUENCIES];
-static fusion_sample_format_t* old_data;    // store old samples for multi
 #endif
 
 /* Private function prototypes --------------------------------------------- */
@@ -92,6 +103,7 @@ static int generate_bit_flags(int dec);
 static bool add_sensor(int sensor_ix, char *name_buffer);
 static bool add_axis(int sensor_ix, char *name_buffer);
 static float highest_frequency(float *frequencies, size_t size);
+static bool build_fusion_axis_map(void);
 #if MULTI_FREQ_ENABLED == 1
 static float calc_gcd(float time1, float time2);
 static void get_multi_freq_combinations(int row, int col, float* mat_period, float* actual_comb, int ix, vector<float>* freq_comb, vector<int>* mem_fact, float allowed_period);
@@ -171,6 +183,10 @@ bool ei_connect_fusion_list(const char *input_list, ei_fusion_list_format format
 
     ei_free(input_string);
 
+    if (is_fusion) {
+        is_fusion = build_fusion_axis_map();
+    }
+
     return is_fusion;
 }
 
@@ -180,15 +196,9 @@ bool ei_connect_fusion_list(const char *input_list, ei_fusion_list_format format
  */
 void ei_fusion_read_axis_data(void)
 {
+    EI_TRACE_ZONE("fusion_read");
     EiDeviceInfo* dev = EiDeviceInfo::get_device();
     fusion_sample_format_t *sensor_data;
-    fusion_sample_format_t *data;
-    uint32_t loc = 0;
-
-    data = (fusion_sample_format_t *)ei_malloc(sizeof(fusion_sample_format_t) * num_fusion_axis);
-    if (data == NULL) {
-        return;
-    }
 
     for (int i = 0; i < num_fusions; i++) {
 
@@ -198,28 +208,16 @@ void ei_fusion_read_axis_data(void)
                 fusion_sensors[i]->num_axis); // read sensor data from sensor file
         }
 
-        if (sensor_data != NULL) {
-            for (int j = 0; j < fusion_sensors[i]->num_axis; j++) {
-                if (fusion_sensors[i]->axis_flag_used & (1 << j)) {
-                    data[loc++] = *(sensor_data + j); // add sensor data to fusion data
-                }
-            }
-        }
-        else { // No data, zero fill
-            for (int j = 0; j < fusion_sensors[i]->num_axis; j++) {
-                if (fusion_sensors[i]->axis_flag_used & (1 << j)) {
-                    data[loc++] = 0;
-                }
-            }
+        for (int loc = fusion_axis_start[i]; loc < fusion_axis_start[i + 1]; loc++) {
+            // add sensor data to fusion data, no data: zero fill
+            fusion_frame[loc] = (sensor_data != NULL) ? sensor_data[fusion_axis_map[loc]] : 0;
         }
     }
 
     if (fusion_cb_sampler(
-            (const void *)&data[0],
+            (const void *)&fusion_frame[0],
             (sizeof(fusion_sample_format_t) * num_fusion_axis))) // send fusion data to sampler
         dev->stop_sample_thread(); // if last sample detach
-
-    ei_free(data);
 }
 
 #if MULTI_FREQ_ENABLED == 1
@@ -231,15 +229,8 @@ void ei_fusion_multi_read_axis_data(uint8_t flag_read)
 {
    EiDeviceInfo* dev = EiDeviceInfo::get_device();
    fusion_sample_format_t *sensor_data;
-   fusion_sample_format_t *data;
-   uint32_t loc = 0;
 
    if (flag_read != 0) {
-       data = (fusion_sample_format_t *)ei_malloc(sizeof(fusion_sample_format_t) * num_fusion_axis);
-       if (data == NULL) {
-           return;
-       }
-
        for (int i = 0; i < num_fusions; i++) {
 
            sensor_data = NULL;
@@ -249,40 +240,23 @@ void ei_fusion_multi_read_axis_data(uint8_t flag_read)
                    fusion_sensors[i]->num_axis); // read sensor data from sensor file
            }
 
+           // not sampled, keep last value
            if (sensor_data != NULL) {
-               for (int j = 0; j < fusion_sensors[i]->num_axis; j++, loc++) {
-                   if (fusion_sensors[i]->axis_flag_used & (1 << j)) {
-                       data[loc] = *(sensor_data + j); // add sensor data to fusion data
-                       if (old_data != nullptr) {
-
-                        old_data[loc] = data[loc];       // store in old structure
-                        }
-                   }
-               }
-           }
-           else { // No data, zero fill
-               for (int j = 0; j < fusion_sensors[i]->num_axis; j++, loc++) {
-                   if (fusion_sensors[i]->axis_flag_used & (1 << j)) {
-                       data[loc] = old_data[loc];       // not sampled, use last value
-                   }
+               for (int loc = fusion_axis_start[i]; loc < fusion_axis_start[i + 1]; loc++) {
+                   fusion_frame[loc] = sensor_data[fusion_axis_map[loc]]; // add sensor data to fusion data
                }
            }
        }
 
        if (fusion_cb_sampler(
-               (const void *)&data[0],
+               (const void *)&fusion_frame[0],
                (sizeof(fusion_sample_format_t) * num_fusion_axis))) {
            dev->stop_sample_thread(); // if last sample detach
-           ei_free(old_data);
-           // send fusion data to sampler
        }
-
-       ei_free(data);
    }
    else {
        if (fusion_cb_sampler(nullptr, 0)) {
            dev->stop_sample_thread(); // if last sample detach
-           ei_free(old_data);
        }
    }
 
@@ -303,6 +277,8 @@ bool ei_fusion_sample_start(sampler_callback callsampler, float sample_interval_
     fusion_cb_sampler = callsampler; // connect cb sampler (used in ei_fusion_read_data())
     bool started = false;
 
+    memset(fusion_frame, 0, sizeof(fusion_frame));
+
     if (fusion_cb_sampler != nullptr) {
 #if MULTI_FREQ_ENABLED == 1
         if (num_fusions == 1) {
@@ -331,6 +307,8 @@ bool ei_multi_fusion_sample_start(sampler_callback callsampler, float multi_samp
         return false;
     }
     else {
+        memset(fusion_frame, 0, sizeof(fusion_frame));
+
         if (ei_fusion_calc_optimal_frequencies(num_fusions, EI_MAX_FREQUENCIES, (1000.0f/multi_sample_interval_ms)) == false) {
             ei_printf("ERR: Unable to calculate the optimal frequency\n");
             return false;
@@ -408,9 +386,6 @@ bool ei_fusion_setup_data_sampling(void)
     bool ret = false;
 
 #if MULTI_FREQ_ENABLED == 1
-    old_data = (fusion_sample_format_t *)ei_malloc(sizeof(fusion_sample_format_t) * num_fusion_axis);
-    memset(old_data, 0, sizeof(fusion_sample_format_t) * num_fusion_axis);
-
     if (num_fusions == 1) {
         ret = ei_sampler_start_sampling(
                 &payload,
@@ -423,11 +398,6 @@ bool ei_fusion_setup_data_sampling(void)
                 &ei_multi_fusion_sample_start,
                 (sizeof(fusion_sample_format_t) * num_fusion_axis));
     }
-
-    if (ret == false) {
-        ei_free(old_data);  //
-    }
-
 #else
     ret = ei_sampler_start_sampling(
             &payload,
@@ -753,6 +723,31 @@ static bool add_axis(int sensor_ix, char *name_buffer)
     return is_fusion;
 }
 
+/**
+ * @brief      Build the gather table for the connected fusion list, so the
+ *             sample path doesn't have to walk the axis flags
+ * @return     false if too many axes are selected
+ */
+static bool build_fusion_axis_map(void)
+{
+    int loc = 0;
+
+    for (int i = 0; i < num_fusions; i++) {
+        fusion_axis_start[i] = loc;
+        for (int j = 0; j < fusion_sensors[i]->num_axis; j++) {
+            if (fusion_sensors[i]->axis_flag_used & (1 << j)) {
+                if (loc >= EI_MAX_SENSOR_AXES) {
+                    return false;
+                }
+                fusion_axis_map[loc++] = j;
+            }
+        }
+    }
+    fusion_axis_start[num_fusions] = loc;
+
+    return true;
+}
+
 /**
  * @brief Run trough freq array and return highest
  *
@@ -0,0 +1,121 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ei_trace_lib.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include <inttypes.h>
+
+#if EI_TRACE_ENABLED
+
+static void print_us(uint64_t ns)
+{
+    ei_printf("%" PRIu64 ".%03u", ns / 1000, (unsigned)(ns % 1000));
+}
+
+/**
+ * @brief Unwrap the start of an event to 64 bits. Events are stored when they
+ * end, so their ends are (almost) in order. A signed delta from the previous
+ * end also covers zones of other threads that ended slightly earlier.
+ */
+static uint64_t unwrap_start(const ei_trace_event_t *event, uint64_t *prev_end, bool *first)
+{
+    uint32_t end = event->start + event->duration;
+
+    if (*first) {
+        // start high enough that no zone can begin below 0
+        *prev_end = (1ULL << 34) + end;
+        *first = false;
+    }
+    else {
+        *prev_end += (int64_t)(int32_t)(end - (uint32_t)*prev_end);
+    }
+
+    return *prev_end - event->duration;
+}
+
+bool ei_trace_print_chrome_json(void)
+{
+    ei_trace_event_t event;
+    // stop recording, otherwise the ring changes between the two passes
+    bool was_enabled = ei_trace_set_enabled(false);
+    uint32_t count = ei_trace_event_count();
+    uint32_t first_ix = count > EI_TRACE_RING_SIZE ? count - EI_TRACE_RING_SIZE : 0;
+    uint64_t prev_end = 0;
+    uint64_t origin = UINT64_MAX;
+    bool first = true;
+    uint32_t printed = 0;
+
+    // first pass finds the earliest start, so timestamps begin at 0
+    for (uint32_t ix = first_ix; ix != count; ix++) {
+        if (ei_trace_get_event(ix, &event)) {
+            uint64_t start = unwrap_start(&event, &prev_end, &first);
+            origin = start < origin ? start : origin;
+        }
+    }
+
+    ei_printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    first = true;
+    for (uint32_t ix = first_ix; ix != count; ix++) {
+        if (!ei_trace_get_event(ix, &event)) {
+            continue;
+        }
+        uint64_t start = unwrap_start(&event, &prev_end, &first);
+
+        ei_printf("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":",
+                  printed ? ",\n" : "", event.name, event.thread_id);
+        print_us(ei_trace_cycles_to_ns(start - origin));
+        ei_printf(",\"dur\":");
+        print_us(ei_trace_cycles_to_ns(event.duration));
+        ei_printf("}");
+        printed++;
+    }
+
+    ei_printf("\n],\"otherData\":{\"events\":%" PRIu32 ",\"overwritten\":%" PRIu32 "}}\n",
+              printed, first_ix);
+
+    ei_trace_set_enabled(was_enabled);
+
+    return true;
+}
+
+#else
+
+bool ei_trace_print_chrome_json(void)
+{
+    return false;
+}
+
+#endif // EI_TRACE_ENABLED
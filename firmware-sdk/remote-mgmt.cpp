@@ -141,6 +141,60 @@ int get_snapshot_frame_msg(uint8_t* buf, size_t buf_len, const char* frame)
     return encoded.len;
 }
 
+int get_sensor_frames_msg(uint8_t* buf, size_t buf_len, const float* values, size_t axes, size_t frames, uint32_t dropped)
+{
+    UsefulBuf cbor_buf = {
+        .ptr = buf,
+        .len = buf_len
+    };
+    QCBOREncodeContext ec;
+    UsefulBufC encoded;
+
+    QCBOREncode_Init(&ec, cbor_buf);
+    QCBOREncode_OpenMap(&ec);
+    QCBOREncode_OpenMapInMap(&ec, "sensorFrames");
+    QCBOREncode_AddInt64ToMap(&ec, "axes", axes);
+    QCBOREncode_AddInt64ToMap(&ec, "dropped", dropped);
+    QCBOREncode_OpenArrayInMap(&ec, "values");
+    for (size_t ix = 0; ix < axes * frames; ix++) {
+        QCBOREncode_AddDouble(&ec, values[ix]);
+    }
+    QCBOREncode_CloseArray(&ec); // values
+    QCBOREncode_CloseMap(&ec); // sensorFrames map
+    QCBOREncode_CloseMap(&ec); // main object map
+
+    if(QCBOREncode_Finish(&ec, &encoded)) {
+        return 0;
+    }
+
+    return encoded.len;
+}
+
+int get_inference_event_msg(uint8_t* buf, size_t buf_len, const char* label, float value, float anomaly)
+{
+    UsefulBuf cbor_buf = {
+        .ptr = buf,
+        .len = buf_len
+    };
+    QCBOREncodeContext ec;
+    UsefulBufC encoded;
+
+    QCBOREncode_Init(&ec, cbor_buf);
+    QCBOREncode_OpenMap(&ec);
+    QCBOREncode_OpenMapInMap(&ec, "inferenceEvent");
+    QCBOREncode_AddSZStringToMap(&ec, "label", label);
+    QCBOREncode_AddDoubleToMap(&ec, "value", value);
+    QCBOREncode_AddDoubleToMap(&ec, "anomaly", anomaly);
+    QCBOREncode_CloseMap(&ec); // inferenceEvent map
+    QCBOREncode_CloseMap(&ec); // main object map
+
+    if(QCBOREncode_Finish(&ec, &encoded)) {
+        return 0;
+    }
+
+    return encoded.len;
+}
+
 int get_hello_msg(uint8_t* buf, size_t buf_len, EiDeviceInfo* device)
 {
     UsefulBuf cbor_buf = {
@@ -177,6 +177,29 @@ int get_sample_finished_msg(uint8_t* buf, size_t buf_len);
  */
 int get_snapshot_frame_msg(uint8_t* buf, size_t buf_len, const char* frame);
 
+/**
+ * @brief Create a message with a batch of live sensor frames (streaming)
+ * @param buf Buffer to write the message to
+ * @param buf_len Length of the buffer
+ * @param values Sensor values, frames one after another
+ * @param axes Number of values in one frame
+ * @param frames Number of frames
+ * @param dropped Total number of frames dropped since the streaming started
+ * @return actual message length
+ */
+int get_sensor_frames_msg(uint8_t* buf, size_t buf_len, const float* values, size_t axes, size_t frames, uint32_t dropped);
+
+/**
+ * @brief Create a message with a change of the smoothed inference result
+ * @param buf Buffer to write the message to
+ * @param buf_len Length of the buffer
+ * @param label New label, 'uncertain' or 'anomaly' included
+ * @param value Score of the label in the window that triggered the event
+ * @param anomaly Anomaly score of that window
+ * @return actual message length
+ */
+int get_inference_event_msg(uint8_t* buf, size_t buf_len, const char* label, float value, float anomaly);
+
 /**
  * @brief Create a hello message (send as a first message to Remote Management Service)
  * @param buf Buffer to write the message to
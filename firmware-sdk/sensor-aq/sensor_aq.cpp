@@ -39,6 +39,10 @@
 //#include "qcbor.h"
 //#include "setup.h"
 #include "sensor_aq.h"
+// ieee754.h has no C++ guards of its own
+extern "C" {
+#include "../QCBOR/src/ieee754.h"
+}
 
 
 extern void ei_printf(const char *format, ...);
@@ -135,6 +139,30 @@ static int sensor_aq_flush_buffer(sensor_aq_ctx *ctx) {
     return AQ_OK;
 }
 
+/**
+ * Encode a single float value
+ */
+static inline void sensor_aq_add_float(QCBOREncodeContext *encode_context, float value, sensor_aq_float_encoding encoding) {
+    switch (encoding) {
+        case AQ_FLOAT_ENCODING_FLOAT32: {
+            uint32_t single;
+            memcpy(&single, &value, sizeof(single));
+            QCBOREncode_AddType7(encode_context, sizeof(single), single);
+            break;
+        }
+        case AQ_FLOAT_ENCODING_HALF:
+            QCBOREncode_AddType7(encode_context, sizeof(uint16_t), IEEE754_FloatToHalf(value));
+            break;
+        case AQ_FLOAT_ENCODING_SMALLEST:
+        default: {
+            // same as QCBOREncode_AddDouble, but without the round trip through double
+            const IEEE754_union smallest = IEEE754_FloatToSmallest(value);
+            QCBOREncode_AddType7(encode_context, smallest.uSize, smallest.uValue);
+            break;
+        }
+    }
+}
+
 /**
  * Initialize a sensor acquisition context
  *
@@ -337,6 +365,20 @@ int sensor_aq_init(sensor_aq_ctx *ctx, sensor_aq_payload_info *payload_info, EI_
  * @param values_size Size of the values
  */
 int sensor_aq_add_data(sensor_aq_ctx *ctx, float values[], size_t values_size) {
+    return sensor_aq_add_data_frames(ctx, values, values_size, 1, AQ_FLOAT_ENCODING_SMALLEST);
+}
+
+/**
+ * Add data to the sensor file for many intervals at the same time
+ * Frames are encoded back to back into the CBOR buffer, which is only written out
+ * when it can't hold another frame or when all frames are added
+ * @param ctx The context
+ * @param values Values for all frames, frame after frame (frames * values_size items)
+ * @param values_size Number of values in a single frame
+ * @param frames Number of frames
+ * @param encoding How the values should be encoded
+ */
+int sensor_aq_add_data_frames(sensor_aq_ctx *ctx, const float values[], size_t values_size, size_t frames, sensor_aq_float_encoding encoding) {
     if (values_size != ctx->axis_count) {
         return AQ_VALUES_SIZE_DOES_NOT_MATCH_AXIS_COUNT;
     }
@@ -345,25 +387,40 @@ int sensor_aq_add_data(sensor_aq_ctx *ctx, float values[], size_t values_size) {
         return AQ_STREAM_IS_NULL;
     }
 
-    // clear memory
-    memset(ctx->cbor_buffer.ptr, 0, ctx->cbor_buffer.len);
+    // worst case size of a frame, array header + double for every value
+    const size_t max_frame_size = 1 + values_size * 9;
 
-    // re-initialize
+    if (max_frame_size > ctx->cbor_buffer.len) {
+        return AQ_OUT_OF_MEM;
+    }
+
+    // re-initialize (buffer is cleared after every flush)
     QCBOREncode_Init(&ctx->encode_context, ctx->cbor_buffer);
 
-    // If we only have a single axis then emit flattened array (saves space)
-    if (values_size == 1) {
-        QCBOREncode_AddDouble(&ctx->encode_context, values[0]);
-    }
-    else {
-        // otherwise create an array
-        QCBOREncode_OpenArray(&ctx->encode_context);
+    for (size_t frame = 0; frame < frames; frame++) {
+        if (UsefulOutBuf_RoomLeft(&ctx->encode_context.OutBuf) < max_frame_size) {
+            int fr = sensor_aq_flush_buffer(ctx);
+            if (fr != AQ_OK) {
+                return fr;
+            }
+        }
 
-        for (size_t ix = 0; ix < values_size; ix++) {
-            QCBOREncode_AddDouble(&ctx->encode_context, values[ix]);
+        const float *frame_values = &values[frame * values_size];
+
+        // If we only have a single axis then emit flattened array (saves space)
+        if (values_size == 1) {
+            sensor_aq_add_float(&ctx->encode_context, frame_values[0], encoding);
         }
+        else {
+            // otherwise create an array
+            QCBOREncode_OpenArray(&ctx->encode_context);
 
-        QCBOREncode_CloseArray(&ctx->encode_context);
+            for (size_t ix = 0; ix < values_size; ix++) {
+                sensor_aq_add_float(&ctx->encode_context, frame_values[ix], encoding);
+            }
+
+            QCBOREncode_CloseArray(&ctx->encode_context);
+        }
     }
 
     return sensor_aq_flush_buffer(ctx);
@@ -91,6 +91,18 @@ typedef enum {
     AQ_OUT_OF_MEM = -6020
 } sensor_aq_status;
 
+/**
+ * How floating point values are encoded in the CBOR payload
+ */
+typedef enum {
+    // Shortest lossless form (half or single precision), same output as sensor_aq_add_data
+    AQ_FLOAT_ENCODING_SMALLEST = 0,
+    // Always single precision, fixed 5 bytes per value
+    AQ_FLOAT_ENCODING_FLOAT32 = 1,
+    // IEEE 754 half precision, fixed 3 bytes per value. Precision is lost!
+    AQ_FLOAT_ENCODING_HALF = 2
+} sensor_aq_float_encoding;
+
 /**
  * Buffer context
  */
@@ -205,6 +217,7 @@ typedef struct {
 int sensor_aq_init(sensor_aq_ctx *ctx, sensor_aq_payload_info *payload_info, EI_SENSOR_AQ_STREAM *stream, bool allow_empty_stream);
 int sensor_aq_add_data(sensor_aq_ctx *ctx, float values[], size_t values_size);
 int sensor_aq_add_data_i16(sensor_aq_ctx *ctx, int16_t values[], size_t values_size);
+int sensor_aq_add_data_frames(sensor_aq_ctx *ctx, const float values[], size_t values_size, size_t frames, sensor_aq_float_encoding encoding);
 int sensor_aq_add_data_batch(sensor_aq_ctx *ctx, int16_t values[], size_t values_size);
 int sensor_aq_finish(sensor_aq_ctx *ctx);
 
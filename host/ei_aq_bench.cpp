@@ -0,0 +1,263 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark of the CBOR encoding of sample frames by sensor_aq. A recording of 3 axes is
+ * encoded frame by frame with sensor_aq_add_data, and in batches (as the sampler does) with
+ * sensor_aq_add_data_frames for every float encoding. The encoded bytes and time per frame are
+ * printed, and every recording is decoded again and its values compared to the input.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "sensor-aq/sensor_aq.h"
+#include "sensor-aq/sensor_aq_none.h"
+#include "QCBOR/inc/qcbor.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+
+#define AXES    3
+
+/* Private variables ------------------------------------------------------- */
+// the encoded recording, written by aq_fwrite at aq_pos
+static std::vector<uint8_t> aq_out;
+static size_t aq_pos;
+
+static size_t aq_fwrite(const void *ptr, size_t size, size_t count, FILE *stream)
+{
+    (void)stream;
+    const size_t len = size * count;
+
+    if (aq_pos + len > aq_out.size()) {
+        aq_out.resize(aq_pos + len);
+    }
+    memcpy(aq_out.data() + aq_pos, ptr, len);
+    aq_pos += len;
+
+    return count;
+}
+
+static int aq_fseek(FILE *stream, long int offset, int origin)
+{
+    (void)stream;
+    if (origin != SEEK_SET || offset < 0 || (size_t)offset > aq_out.size()) {
+        return -1;
+    }
+    aq_pos = (size_t)offset;
+
+    return 0;
+}
+
+/**
+ * @brief      Decode the recording and compare its values to the input frames
+ *
+ * @param[in]  expected  The input frames
+ * @param[in]  frames    The frame count
+ * @param[in]  rel_tol   Relative tolerance of a value, 0 for lossless encodings
+ *
+ * @return     True if the recording is valid CBOR and holds the input frames
+ */
+static bool aq_verify(const std::vector<float> &expected, size_t frames, float rel_tol)
+{
+    QCBORDecodeContext dc;
+    QCBORItem item;
+    QCBORError err;
+    size_t values = 0;
+    int values_level = -1;
+    int next_level = 0;
+    size_t decoded_bytes = 0;
+    bool ok = true;
+
+    QCBORDecode_Init(&dc, (UsefulBufC){ aq_out.data(), aq_out.size() }, QCBOR_DECODE_MODE_NORMAL);
+    while ((err = QCBORDecode_GetNext(&dc, &item)) == QCBOR_SUCCESS) {
+        next_level = item.uNextNestLevel;
+        decoded_bytes = UsefulInputBuf_Tell(&dc.InBuf);
+        if (item.uDataType == QCBOR_TYPE_ARRAY && item.uLabelType == QCBOR_TYPE_TEXT_STRING &&
+            item.label.string.len == 6 && memcmp(item.label.string.ptr, "values", 6) == 0) {
+            values_level = item.uNestingLevel;
+            continue;
+        }
+        if (values_level < 0) {
+            continue;
+        }
+        // values is the last entry of the recording
+        if (item.uNestingLevel <= values_level) {
+            ok = false;
+            continue;
+        }
+        if (item.uDataType == QCBOR_TYPE_ARRAY) {
+            if (item.val.uCount != AXES) {
+                ok = false;
+            }
+            continue;
+        }
+        if (item.uDataType != QCBOR_TYPE_DOUBLE || values >= expected.size()) {
+            ok = false;
+            continue;
+        }
+        const float value = (float)item.val.dfnum;
+        const float want = expected[values++];
+        if (fabsf(value - want) > rel_tol * fabsf(want)) {
+            ok = false;
+        }
+    }
+
+    // QCBORDecode_Finish can't be used: this QCBOR doesn't count an indefinite array closed by
+    // its break against the map around it, so it reports the payload map as still open. Require
+    // that the items decoded without error up to the last byte and that the break closed the
+    // values array instead.
+    if (err != QCBOR_ERR_HIT_END || decoded_bytes != aq_out.size() ||
+        values_level < 0 || next_level > values_level || values != frames * AXES) {
+        ok = false;
+    }
+
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    size_t frames = 1 << 16;
+    size_t batch = 16;
+    unsigned int seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:b:s:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                frames = (size_t)atoi(optarg);
+                break;
+            case 'b':
+                batch = (size_t)atoi(optarg);
+                break;
+            case 's':
+                seed = (unsigned int)atoi(optarg);
+                break;
+            default:
+                ei_printf("Usage: %s [-n <frames>] [-b <frames per write>] [-s <seed>]\n", argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (frames < 1 || batch < 1) {
+        ei_printf("ERR: -n and -b must be at least 1\n");
+        return 1;
+    }
+
+    // accelerometer in m/s2, 16 bit over +-2g, resting on the z axis
+    srand(seed);
+    std::vector<float> data(frames * AXES);
+    const float lsb = 4.0f * 9.80665f / 65536.0f;
+    for (size_t ix = 0; ix < data.size(); ix++) {
+        const float g = (ix % AXES == 2) ? 9.80665f : 0.0f;
+        data[ix] = roundf((g + ((float)rand() / (float)RAND_MAX - 0.5f)) / lsb) * lsb;
+    }
+
+    sensor_aq_payload_info payload = {
+        "host", "EI_AQ_BENCH", 10.0f,
+        { { "accX", "m/s2" }, { "accY", "m/s2" }, { "accZ", "m/s2" } }
+    };
+
+    struct {
+        const char *name;
+        bool per_frame;
+        sensor_aq_float_encoding encoding;
+        float rel_tol;
+    } modes[] = {
+        { "add_data", true, AQ_FLOAT_ENCODING_SMALLEST, 0.0f },
+        { "smallest", false, AQ_FLOAT_ENCODING_SMALLEST, 0.0f },
+        { "float32", false, AQ_FLOAT_ENCODING_FLOAT32, 0.0f },
+        // 11 bit significand
+        { "half", false, AQ_FLOAT_ENCODING_HALF, 1.0f / 1024.0f },
+    };
+    bool ok = true;
+
+    ei_printf("      mode  bytes/frame  us/frame  decoded\n");
+    for (auto &mode : modes) {
+        // the sampler's buffer size
+        static unsigned char buffer[1024];
+        sensor_aq_signing_ctx_t signing_ctx;
+        sensor_aq_ctx ctx = {
+            { buffer, sizeof(buffer) },
+            &signing_ctx,
+            &aq_fwrite,
+            &aq_fseek,
+            nullptr,
+        };
+
+        aq_out.clear();
+        aq_pos = 0;
+        sensor_aq_init_none_context(&signing_ctx);
+        // any non-NULL stream, aq_fwrite ignores it
+        if (sensor_aq_init(&ctx, &payload, stdout, false) != AQ_OK) {
+            ei_printf("ERR: sensor_aq_init failed\n");
+            return 1;
+        }
+        const size_t header_bytes = aq_out.size();
+
+        int r = AQ_OK;
+        uint64_t start_us = ei_read_timer_us();
+        for (size_t frame = 0; frame < frames && r == AQ_OK; frame += batch) {
+            const size_t count = frames - frame < batch ? frames - frame : batch;
+            if (mode.per_frame) {
+                for (size_t ix = 0; ix < count && r == AQ_OK; ix++) {
+                    r = sensor_aq_add_data(&ctx, &data[(frame + ix) * AXES], AXES);
+                }
+            }
+            else {
+                r = sensor_aq_add_data_frames(&ctx, &data[frame * AXES], AXES, count, mode.encoding);
+            }
+        }
+        uint64_t elapsed_us = ei_read_timer_us() - start_us;
+        const size_t data_bytes = aq_out.size() - header_bytes;
+
+        if (r == AQ_OK) {
+            r = sensor_aq_finish(&ctx);
+        }
+        const bool valid = r == AQ_OK && aq_verify(data, frames, mode.rel_tol);
+        if (!valid) {
+            ok = false;
+        }
+
+        ei_printf("%10s  %11.3f  %8.4f  %7s\n", mode.name, (double)data_bytes / frames,
+            (double)elapsed_us / frames, valid ? "ok" : "FAILED");
+    }
+
+    if (!ok) {
+        ei_printf("ERR: Encoding failed or the recording doesn't decode to the input\n");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,839 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Plans the tensor arena of a .tflite model offline, for deployments that run the model with
+ * the TFLite Micro interpreter (tflite_micro.h) instead of EON. Compares the runtime greedy
+ * planner against best-fit-decreasing and interval colouring (optionally on a reordered
+ * operator list), prints the lifetime and offset of every planned tensor, and writes a copy of
+ * the model with the best plan stored as "OfflineMemoryAllocation" metadata, which the
+ * micro allocator uses instead of planning at runtime.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/all_ops_resolver.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/memory_helpers.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/micro_arena_constants.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/micro_interpreter.h"
+#include "edge-impulse-sdk/tensorflow/lite/schema/schema_generated.h"
+#include "edge-impulse-sdk/tensorflow/lite/schema/schema_generated_full.h"
+#include "edge-impulse-sdk/tensorflow/lite/schema/schema_utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+/* Constants --------------------------------------------------------------- */
+// metadata entry read by AllocationInfoBuilder::GetOfflinePlannedOffsets()
+static const char offline_metadata_name[] = "OfflineMemoryAllocation";
+static const uint32_t offline_metadata_version = 1;
+// arena handed to the interpreter when measuring, only the used part is reported
+static const size_t measure_arena_size = 64 * 1024 * 1024;
+
+typedef enum {
+    STRATEGY_GREEDY = 0,
+    STRATEGY_BEST_FIT,
+    STRATEGY_INTERVAL,
+    STRATEGY_COUNT
+} plan_strategy_t;
+
+static const char *strategy_names[STRATEGY_COUNT] = { "greedy", "bfd", "interval" };
+
+/* Private types ----------------------------------------------------------- */
+typedef struct {
+    int tensor;             // index in the subgraph
+    int size;               // bytes, aligned like the micro allocator does
+    int first_created;      // allocation scope, 0 is before the first operator
+    int last_used;
+} plan_buffer_t;
+
+typedef struct {
+    plan_strategy_t strategy;
+    bool reordered;
+    std::vector<int> order;             // operator execution order
+    std::vector<plan_buffer_t> buffers; // lifetimes under that order
+    std::vector<int> offsets;           // one per buffer
+    size_t size;                        // planned arena for the tensors
+    size_t lower_bound;                 // largest sum of live tensors in any scope
+} arena_plan_t;
+
+/* Private functions ------------------------------------------------------- */
+static void print_usage(const char *name)
+{
+    ei_printf("Usage: %s [options] <model.tflite>\n", name);
+    ei_printf("  -s <strategy>  greedy, bfd, interval or best (default: best)\n");
+    ei_printf("  -o <file>      write the model with the offline plan to <file>\n");
+    ei_printf("  -R             don't reorder operators\n");
+    ei_printf("  -q             don't print the per tensor report\n");
+}
+
+static bool read_file(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    data.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+static bool write_file(const char *path, const uint8_t *data, size_t size)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+
+    bool ok = fwrite(data, 1, size, f) == size;
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * @brief      Whether the micro allocator places the tensor in the planned (head) part
+ *             of the arena: not a constant, not a variable and not empty
+ */
+static bool is_planned_tensor(const tflite::Model *model, const tflite::Tensor *tensor, int *size)
+{
+    const tflite::Buffer *buffer = model->buffers()->Get(tensor->buffer());
+    size_t bytes = 0;
+    size_t type_size = 0;
+
+    if (buffer && buffer->data() && buffer->data()->size() > 0) {
+        return false;
+    }
+    if (tensor->is_variable()) {
+        return false;
+    }
+    if (tflite::BytesRequiredForTensor(*tensor, &bytes, &type_size) != kTfLiteOk || bytes == 0) {
+        return false;
+    }
+
+    *size = (int)tflite::AlignSizeUp(bytes, tflite::MicroArenaBufferAlignment());
+    return true;
+}
+
+/**
+ * @brief      Tensor lifetimes for an operator order, same rules as
+ *             AllocationInfoBuilder::MarkAllocationLifetimes()
+ */
+static void mark_lifetimes(const tflite::Model *model, const std::vector<int> &order,
+    std::vector<plan_buffer_t> &buffers)
+{
+    const tflite::SubGraph *subgraph = model->subgraphs()->Get(0);
+    const int tensor_count = (int)subgraph->tensors()->size();
+    std::vector<int> first(tensor_count, -1);
+    std::vector<int> last(tensor_count, -1);
+    int scope = 0;
+
+    for (size_t ix = 0; subgraph->inputs() && ix < subgraph->inputs()->size(); ix++) {
+        int tensor = subgraph->inputs()->Get(ix);
+        first[tensor] = scope;
+        last[tensor] = scope;
+    }
+
+    for (size_t ix = 0; ix < order.size(); ix++) {
+        const tflite::Operator *op = subgraph->operators()->Get(order[ix]);
+        scope++;
+
+        for (size_t o = 0; op->outputs() && o < op->outputs()->size(); o++) {
+            int tensor = op->outputs()->Get(o);
+            if (first[tensor] == -1) {
+                first[tensor] = scope;
+            }
+            last[tensor] = scope;
+        }
+        for (size_t i = 0; op->inputs() && i < op->inputs()->size(); i++) {
+            int tensor = op->inputs()->Get(i);
+            // optional inputs are -1
+            if (tensor >= 0) {
+                last[tensor] = scope;
+            }
+        }
+    }
+
+    for (size_t ix = 0; subgraph->outputs() && ix < subgraph->outputs()->size(); ix++) {
+        int tensor = subgraph->outputs()->Get(ix);
+        if (first[tensor] == -1) {
+            first[tensor] = scope;
+        }
+        last[tensor] = scope;
+    }
+
+    buffers.clear();
+    for (int tensor = 0; tensor < tensor_count; tensor++) {
+        plan_buffer_t buffer;
+        buffer.tensor = tensor;
+        if (first[tensor] == -1 ||
+            !is_planned_tensor(model, subgraph->tensors()->Get(tensor), &buffer.size)) {
+            continue;
+        }
+        buffer.first_created = first[tensor];
+        buffer.last_used = last[tensor];
+        buffers.push_back(buffer);
+    }
+}
+
+static bool lifetimes_overlap(const plan_buffer_t &a, const plan_buffer_t &b)
+{
+    return a.first_created <= b.last_used && b.first_created <= a.last_used;
+}
+
+static size_t live_lower_bound(const std::vector<plan_buffer_t> &buffers)
+{
+    int last_scope = 0;
+    for (const plan_buffer_t &b : buffers) {
+        last_scope = std::max(last_scope, b.last_used);
+    }
+
+    size_t bound = 0;
+    for (int scope = 0; scope <= last_scope; scope++) {
+        size_t live = 0;
+        for (const plan_buffer_t &b : buffers) {
+            if (b.first_created <= scope && scope <= b.last_used) {
+                live += (size_t)b.size;
+            }
+        }
+        bound = std::max(bound, live);
+    }
+    return bound;
+}
+
+/**
+ * @brief      The planner used at runtime by the micro allocator
+ */
+static bool plan_greedy(const std::vector<plan_buffer_t> &buffers, std::vector<int> &offsets, size_t *size)
+{
+    std::vector<uint8_t> scratch(buffers.size() * tflite::GreedyMemoryPlanner::per_buffer_size() + 16);
+    tflite::GreedyMemoryPlanner planner;
+
+    if (planner.Init(scratch.data(), (int)scratch.size()) != kTfLiteOk) {
+        return false;
+    }
+    for (const plan_buffer_t &b : buffers) {
+        if (planner.AddBuffer(b.size, b.first_created, b.last_used) != kTfLiteOk) {
+            return false;
+        }
+    }
+
+    offsets.resize(buffers.size());
+    for (size_t ix = 0; ix < buffers.size(); ix++) {
+        if (planner.GetOffsetForBuffer((int)ix, &offsets[ix]) != kTfLiteOk) {
+            return false;
+        }
+    }
+    *size = planner.GetMaximumMemorySize();
+    return true;
+}
+
+/**
+ * @brief      Place buffers one by one in the given order, below or between the buffers
+ *             already placed whose lifetime overlaps. First fit takes the lowest gap that
+ *             is large enough, best fit the smallest one.
+ */
+static size_t place_buffers(const std::vector<plan_buffer_t> &buffers, const std::vector<size_t> &placement_order,
+    bool best_fit, std::vector<int> &offsets)
+{
+    std::vector<bool> placed(buffers.size(), false);
+    std::vector<std::pair<int, int>> active; // offset, end of the overlapping buffers
+    size_t arena_size = 0;
+
+    offsets.assign(buffers.size(), 0);
+
+    for (size_t current : placement_order) {
+        const plan_buffer_t &wanted = buffers[current];
+
+        active.clear();
+        for (size_t ix = 0; ix < buffers.size(); ix++) {
+            if (placed[ix] && lifetimes_overlap(buffers[ix], wanted)) {
+                active.push_back(std::make_pair(offsets[ix], offsets[ix] + buffers[ix].size));
+            }
+        }
+        std::sort(active.begin(), active.end());
+
+        int candidate = 0;
+        int best_offset = -1;
+        int best_gap = 0;
+        for (const std::pair<int, int> &a : active) {
+            int gap = a.first - candidate;
+            if (gap >= wanted.size && (best_offset < 0 || gap < best_gap)) {
+                best_offset = candidate;
+                best_gap = gap;
+                if (!best_fit) {
+                    break;
+                }
+            }
+            candidate = std::max(candidate, a.second);
+        }
+
+        offsets[current] = best_offset >= 0 ? best_offset : candidate;
+        placed[current] = true;
+        arena_size = std::max(arena_size, (size_t)(offsets[current] + wanted.size));
+    }
+
+    return arena_size;
+}
+
+/**
+ * @brief      Largest buffers first, longest lifetime breaking ties
+ */
+static size_t plan_best_fit(const std::vector<plan_buffer_t> &buffers, std::vector<int> &offsets)
+{
+    std::vector<size_t> order(buffers.size());
+    for (size_t ix = 0; ix < order.size(); ix++) {
+        order[ix] = ix;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buffers](size_t a, size_t b) {
+        if (buffers[a].size != buffers[b].size) {
+            return buffers[a].size > buffers[b].size;
+        }
+        return (buffers[a].last_used - buffers[a].first_created) >
+            (buffers[b].last_used - buffers[b].first_created);
+    });
+
+    return place_buffers(buffers, order, true, offsets);
+}
+
+/**
+ * @brief      Interval colouring: buffers in the order they are created, each at the lowest
+ *             offset that is free for its whole lifetime
+ */
+static size_t plan_interval(const std::vector<plan_buffer_t> &buffers, std::vector<int> &offsets)
+{
+    std::vector<size_t> order(buffers.size());
+    for (size_t ix = 0; ix < order.size(); ix++) {
+        order[ix] = ix;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buffers](size_t a, size_t b) {
+        if (buffers[a].first_created != buffers[b].first_created) {
+            return buffers[a].first_created < buffers[b].first_created;
+        }
+        return buffers[a].size > buffers[b].size;
+    });
+
+    return place_buffers(buffers, order, false, offsets);
+}
+
+/**
+ * @brief      Operators can only be reordered in a single subgraph without resource
+ *             variables, where the data flow defines all dependencies
+ */
+static bool can_reorder(const tflite::Model *model)
+{
+    const tflite::SubGraph *subgraph = model->subgraphs()->Get(0);
+
+    for (size_t ix = 0; ix < subgraph->tensors()->size(); ix++) {
+        if (subgraph->tensors()->Get(ix)->is_variable()) {
+            return false;
+        }
+    }
+
+    for (size_t ix = 0; ix < subgraph->operators()->size(); ix++) {
+        const tflite::Operator *op = subgraph->operators()->Get(ix);
+        switch (tflite::GetBuiltinCode(model->operator_codes()->Get(op->opcode_index()))) {
+            case tflite::BuiltinOperator_VAR_HANDLE:
+            case tflite::BuiltinOperator_READ_VARIABLE:
+            case tflite::BuiltinOperator_ASSIGN_VARIABLE:
+            case tflite::BuiltinOperator_CALL_ONCE:
+            case tflite::BuiltinOperator_CUSTOM:
+                return false;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief      List scheduling: of the operators whose inputs are ready, run the one that
+ *             adds the least live memory, then the one that frees the most, then the one
+ *             that came first in the model
+ */
+static std::vector<int> reorder_operators(const tflite::Model *model)
+{
+    const tflite::SubGraph *subgraph = model->subgraphs()->Get(0);
+    const int op_count = (int)subgraph->operators()->size();
+    const int tensor_count = (int)subgraph->tensors()->size();
+    std::vector<int> tensor_size(tensor_count, 0);
+    std::vector<int> producer(tensor_count, -1);
+    std::vector<int> consumers(tensor_count, 0);
+    std::vector<bool> is_output(tensor_count, false);
+    std::vector<bool> done(op_count, false);
+    std::vector<int> order;
+
+    for (int tensor = 0; tensor < tensor_count; tensor++) {
+        int size = 0;
+        if (is_planned_tensor(model, subgraph->tensors()->Get(tensor), &size)) {
+            tensor_size[tensor] = size;
+        }
+    }
+    for (size_t ix = 0; subgraph->outputs() && ix < subgraph->outputs()->size(); ix++) {
+        is_output[subgraph->outputs()->Get(ix)] = true;
+    }
+    for (int op_ix = 0; op_ix < op_count; op_ix++) {
+        const tflite::Operator *op = subgraph->operators()->Get(op_ix);
+        for (size_t o = 0; op->outputs() && o < op->outputs()->size(); o++) {
+            producer[op->outputs()->Get(o)] = op_ix;
+        }
+        for (size_t i = 0; op->inputs() && i < op->inputs()->size(); i++) {
+            if (op->inputs()->Get(i) >= 0) {
+                consumers[op->inputs()->Get(i)]++;
+            }
+        }
+    }
+
+    std::vector<bool> produced(tensor_count, true);
+    for (int tensor = 0; tensor < tensor_count; tensor++) {
+        produced[tensor] = producer[tensor] == -1;
+    }
+
+    while ((int)order.size() < op_count) {
+        int best = -1;
+        long best_added = 0;
+        long best_freed = 0;
+
+        for (int op_ix = 0; op_ix < op_count; op_ix++) {
+            if (done[op_ix]) {
+                continue;
+            }
+            const tflite::Operator *op = subgraph->operators()->Get(op_ix);
+            bool ready = true;
+            long freed = 0;
+            for (size_t i = 0; op->inputs() && i < op->inputs()->size(); i++) {
+                int tensor = op->inputs()->Get(i);
+                if (tensor < 0) {
+                    continue;
+                }
+                if (!produced[tensor]) {
+                    ready = false;
+                    break;
+                }
+                // count a tensor used twice by the same operator once
+                bool seen = false;
+                for (size_t j = 0; j < i; j++) {
+                    seen = seen || op->inputs()->Get(j) == tensor;
+                }
+                if (!seen && !is_output[tensor]) {
+                    int uses = 0;
+                    for (size_t j = 0; j < op->inputs()->size(); j++) {
+                        uses += op->inputs()->Get(j) == tensor ? 1 : 0;
+                    }
+                    if (consumers[tensor] == uses) {
+                        freed += tensor_size[tensor];
+                    }
+                }
+            }
+            if (!ready) {
+                continue;
+            }
+
+            long added = 0;
+            for (size_t o = 0; op->outputs() && o < op->outputs()->size(); o++) {
+                added += tensor_size[op->outputs()->Get(o)];
+            }
+
+            if (best < 0 || added < best_added || (added == best_added && freed > best_freed)) {
+                best = op_ix;
+                best_added = added;
+                best_freed = freed;
+            }
+        }
+
+        if (best < 0) {
+            // not a DAG, keep the model order
+            order.clear();
+            for (int op_ix = 0; op_ix < op_count; op_ix++) {
+                order.push_back(op_ix);
+            }
+            return order;
+        }
+
+        const tflite::Operator *op = subgraph->operators()->Get(best);
+        for (size_t i = 0; op->inputs() && i < op->inputs()->size(); i++) {
+            if (op->inputs()->Get(i) >= 0) {
+                consumers[op->inputs()->Get(i)]--;
+            }
+        }
+        for (size_t o = 0; op->outputs() && o < op->outputs()->size(); o++) {
+            produced[op->outputs()->Get(o)] = true;
+        }
+        done[best] = true;
+        order.push_back(best);
+    }
+
+    return order;
+}
+
+static bool make_plan(const tflite::Model *model, plan_strategy_t strategy, const std::vector<int> &order,
+    arena_plan_t &plan)
+{
+    plan.strategy = strategy;
+    plan.order = order;
+    plan.reordered = false;
+    for (size_t ix = 0; ix < order.size(); ix++) {
+        plan.reordered = plan.reordered || order[ix] != (int)ix;
+    }
+
+    mark_lifetimes(model, order, plan.buffers);
+    plan.lower_bound = live_lower_bound(plan.buffers);
+
+    switch (strategy) {
+        case STRATEGY_GREEDY:
+            return plan_greedy(plan.buffers, plan.offsets, &plan.size);
+        case STRATEGY_BEST_FIT:
+            plan.size = plan_best_fit(plan.buffers, plan.offsets);
+            return true;
+        case STRATEGY_INTERVAL:
+            plan.size = plan_interval(plan.buffers, plan.offsets);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool plan_is_valid(const arena_plan_t &plan)
+{
+    for (size_t a = 0; a < plan.buffers.size(); a++) {
+        for (size_t b = a + 1; b < plan.buffers.size(); b++) {
+            if (lifetimes_overlap(plan.buffers[a], plan.buffers[b]) &&
+                plan.offsets[a] < plan.offsets[b] + plan.buffers[b].size &&
+                plan.offsets[b] < plan.offsets[a] + plan.buffers[a].size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static const char *tensor_type_name(tflite::TensorType type)
+{
+    const char *name = tflite::EnumNameTensorType(type);
+    return (name && name[0]) ? name : "?";
+}
+
+static void print_tensor_report(const tflite::Model *model, const arena_plan_t &plan)
+{
+    const tflite::SubGraph *subgraph = model->subgraphs()->Get(0);
+
+    ei_printf("\nPlanned tensors (%s%s), scope 0 is before the first operator:\n",
+        strategy_names[plan.strategy], plan.reordered ? ", reordered" : "");
+    ei_printf("%6s %10s %8s %6s %6s %10s  %s\n", "tensor", "bytes", "type", "first", "last", "offset", "name");
+
+    for (size_t ix = 0; ix < plan.buffers.size(); ix++) {
+        const plan_buffer_t &b = plan.buffers[ix];
+        const tflite::Tensor *tensor = subgraph->tensors()->Get(b.tensor);
+        ei_printf("%6d %10d %8s %6d %6d %10d  %s\n", b.tensor, b.size, tensor_type_name(tensor->type()),
+            b.first_created, b.last_used, plan.offsets[ix],
+            tensor->name() ? tensor->name()->c_str() : "");
+    }
+
+    if (plan.reordered) {
+        ei_printf("\nOperator order:");
+        for (int op_ix : plan.order) {
+            ei_printf(" %d", op_ix);
+        }
+        ei_printf("\n");
+    }
+}
+
+/**
+ * @brief      Copy of the model with the operators in plan order and the plan offsets in an
+ *             OfflineMemoryAllocation metadata buffer (replacing an existing one)
+ */
+static bool build_planned_model(const uint8_t *model_data, const arena_plan_t &plan,
+    flatbuffers::FlatBufferBuilder &fbb)
+{
+    std::unique_ptr<tflite::ModelT> model(tflite::UnPackModel(model_data));
+    tflite::SubGraphT *subgraph = model->subgraphs[0].get();
+    const size_t tensor_count = subgraph->tensors.size();
+
+    std::vector<std::unique_ptr<tflite::OperatorT>> operators;
+    for (int op_ix : plan.order) {
+        operators.push_back(std::move(subgraph->operators[op_ix]));
+    }
+    subgraph->operators = std::move(operators);
+
+    // [version, subgraph, number of tensors, offset per tensor (-1 = planned online)]
+    std::vector<int32_t> words(3 + tensor_count, tflite::kOnlinePlannedBuffer);
+    words[0] = (int32_t)offline_metadata_version;
+    words[1] = 0;
+    words[2] = (int32_t)tensor_count;
+    for (size_t ix = 0; ix < plan.buffers.size(); ix++) {
+        words[3 + plan.buffers[ix].tensor] = plan.offsets[ix];
+    }
+
+    std::unique_ptr<tflite::BufferT> buffer(new tflite::BufferT());
+    buffer->data.resize(words.size() * sizeof(int32_t));
+    memcpy(buffer->data.data(), words.data(), buffer->data.size());
+
+    tflite::MetadataT *metadata = nullptr;
+    for (std::unique_ptr<tflite::MetadataT> &m : model->metadata) {
+        if (m->name == offline_metadata_name) {
+            metadata = m.get();
+        }
+    }
+    if (metadata && metadata->buffer < model->buffers.size()) {
+        model->buffers[metadata->buffer] = std::move(buffer);
+    }
+    else {
+        if (!metadata) {
+            model->metadata.push_back(std::unique_ptr<tflite::MetadataT>(new tflite::MetadataT()));
+            metadata = model->metadata.back().get();
+            metadata->name = offline_metadata_name;
+        }
+        metadata->buffer = (uint32_t)model->buffers.size();
+        model->buffers.push_back(std::move(buffer));
+    }
+
+    tflite::FinishModelBuffer(fbb, tflite::Model::Pack(fbb, model.get()));
+    return true;
+}
+
+/**
+ * @brief      Allocate the model in the interpreter and run it once on pseudo random input
+ * @return     Arena bytes used by the interpreter, 0 on error
+ */
+static size_t measure_model(const uint8_t *model_data, std::vector<uint8_t> &arena, std::vector<uint8_t> &output)
+{
+    static tflite::AllOpsResolver resolver;
+    const tflite::Model *model = tflite::GetModel(model_data);
+    tflite::MicroInterpreter interpreter(model, resolver, arena.data(), arena.size());
+
+    if (interpreter.AllocateTensors(true) != kTfLiteOk) {
+        return 0;
+    }
+
+    srand(1);
+    for (size_t ix = 0; ix < interpreter.inputs_size(); ix++) {
+        TfLiteTensor *input = interpreter.input(ix);
+        if (input->type == kTfLiteFloat32) {
+            for (size_t v = 0; v < input->bytes / sizeof(float); v++) {
+                input->data.f[v] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+            }
+        }
+        else {
+            for (size_t v = 0; v < input->bytes; v++) {
+                input->data.uint8[v] = (uint8_t)rand();
+            }
+        }
+    }
+
+    if (interpreter.Invoke() != kTfLiteOk) {
+        return 0;
+    }
+
+    output.clear();
+    for (size_t ix = 0; ix < interpreter.outputs_size(); ix++) {
+        TfLiteTensor *t = interpreter.output(ix);
+        output.insert(output.end(), t->data.uint8, t->data.uint8 + t->bytes);
+    }
+
+    return interpreter.arena_used_bytes();
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_path = nullptr;
+    int wanted_strategy = -1;
+    bool allow_reorder = true;
+    bool quiet = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:o:Rqh")) != -1) {
+        switch (opt) {
+            case 's':
+                wanted_strategy = STRATEGY_COUNT;
+                for (int ix = 0; ix < STRATEGY_COUNT; ix++) {
+                    if (strcmp(optarg, strategy_names[ix]) == 0) {
+                        wanted_strategy = ix;
+                    }
+                }
+                if (strcmp(optarg, "best") == 0) {
+                    wanted_strategy = -1;
+                }
+                if (wanted_strategy == STRATEGY_COUNT) {
+                    ei_printf("ERR: Unknown strategy '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'R':
+                allow_reorder = false;
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind >= argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<uint8_t> model_data;
+    if (!read_file(argv[optind], model_data)) {
+        ei_printf("ERR: Failed to read %s\n", argv[optind]);
+        return 1;
+    }
+
+    flatbuffers::Verifier verifier(model_data.data(), model_data.size());
+    if (!tflite::VerifyModelBuffer(verifier)) {
+        ei_printf("ERR: %s is not a valid .tflite model\n", argv[optind]);
+        return 1;
+    }
+
+    const tflite::Model *model = tflite::GetModel(model_data.data());
+    if (model->subgraphs()->size() != 1) {
+        // offline offsets are indexed per subgraph tensor, control flow models are not handled
+        ei_printf("ERR: Only models with a single subgraph can be planned (%d subgraphs)\n",
+            (int)model->subgraphs()->size());
+        return 1;
+    }
+
+    const size_t op_count = model->subgraphs()->Get(0)->operators()->size();
+    std::vector<int> model_order(op_count);
+    for (size_t ix = 0; ix < op_count; ix++) {
+        model_order[ix] = (int)ix;
+    }
+    std::vector<int> reordered = model_order;
+    if (allow_reorder && can_reorder(model)) {
+        reordered = reorder_operators(model);
+    }
+    const bool try_reordered = reordered != model_order;
+
+    // the greedy planner in model order is what the interpreter does today
+    std::vector<arena_plan_t> plans;
+    for (int strategy = 0; strategy < STRATEGY_COUNT; strategy++) {
+        for (int pass = 0; pass < (try_reordered ? 2 : 1); pass++) {
+            if (wanted_strategy >= 0 && wanted_strategy != strategy) {
+                continue;
+            }
+            arena_plan_t plan;
+            if (!make_plan(model, (plan_strategy_t)strategy, pass == 0 ? model_order : reordered, plan) ||
+                !plan_is_valid(plan)) {
+                ei_printf("ERR: Planning with %s failed\n", strategy_names[strategy]);
+                return 1;
+            }
+            plans.push_back(plan);
+        }
+    }
+
+    size_t best = 0;
+    ei_printf("%-10s %-9s %10s %12s\n", "strategy", "order", "arena", "lower bound");
+    for (size_t ix = 0; ix < plans.size(); ix++) {
+        ei_printf("%-10s %-9s %10d %12d\n", strategy_names[plans[ix].strategy],
+            plans[ix].reordered ? "reordered" : "model", (int)plans[ix].size, (int)plans[ix].lower_bound);
+        // on a tie keep the earlier (simpler) plan
+        if (plans[ix].size < plans[best].size) {
+            best = ix;
+        }
+    }
+
+    const arena_plan_t &plan = plans[best];
+    ei_printf("Selected: %s%s, %d bytes of planned tensors\n", strategy_names[plan.strategy],
+        plan.reordered ? " (reordered)" : "", (int)plan.size);
+
+    if (!quiet) {
+        print_tensor_report(model, plan);
+    }
+
+    if (!output_path) {
+        return 0;
+    }
+
+    // the SDK copy of flatbuffers doesn't fall back to a default allocator
+    flatbuffers::DefaultAllocator allocator;
+    flatbuffers::FlatBufferBuilder fbb(64 * 1024, &allocator);
+    if (!build_planned_model(model_data.data(), plan, fbb)) {
+        ei_printf("ERR: Failed to build the planned model\n");
+        return 1;
+    }
+
+    // the interpreter also keeps scratch buffers and its persistent state in the arena, so
+    // compare what it really uses with and without the offline plan
+    std::vector<uint8_t> arena(measure_arena_size);
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+    size_t original_used = measure_model(model_data.data(), arena, expected);
+    std::fill(arena.begin(), arena.end(), 0);
+    size_t planned_used = measure_model(fbb.GetBufferPointer(), arena, actual);
+
+    if (original_used == 0) {
+        // e.g. custom ops, the plan itself doesn't depend on running the model
+        ei_printf("\nWARN: The interpreter can't run this model on the host, the plan is not checked\n");
+    }
+    else if (planned_used == 0) {
+        ei_printf("ERR: The interpreter failed to run the planned model\n");
+        return 1;
+    }
+    else {
+        ei_printf("\nInterpreter arena: %d bytes, %d bytes with the offline plan\n",
+            (int)original_used, (int)planned_used);
+    }
+
+    if (expected != actual) {
+        ei_printf("ERR: Outputs of the planned model differ, not writing it\n");
+        return 1;
+    }
+
+    if (!write_file(output_path, fbb.GetBufferPointer(), fbb.GetSize())) {
+        ei_printf("ERR: Failed to write %s\n", output_path);
+        return 1;
+    }
+    ei_printf("Written %s (%d bytes)\n", output_path, (int)fbb.GetSize());
+    if (planned_used > 0) {
+        ei_printf("Set the arena size to at least %d bytes\n", (int)planned_used);
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_device_host.h"
+#include "ei_sampler.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+/* RAM used as the sample memory, big enough for the default sampling settings */
+#define HOST_MEMORY_BLOCK_SIZE      4096
+#define HOST_MEMORY_BLOCKS          64
+
+EiDeviceInfo* EiDeviceInfo::get_device(void)
+{
+    static EiDeviceRAM<HOST_MEMORY_BLOCK_SIZE, HOST_MEMORY_BLOCKS> memory(sizeof(EiConfig));
+    static EiDeviceHost dev(&memory);
+
+    return &dev;
+}
+
+EiDeviceHost::EiDeviceHost(EiDeviceMemory* mem)
+{
+    EiDeviceInfo::memory = mem;
+    sample_read_cb = nullptr;
+    sampling = false;
+
+    init_device_id();
+    device_type = "HOST_REPLAY";
+}
+
+EiDeviceHost::~EiDeviceHost()
+{
+}
+
+void EiDeviceHost::init_device_id(void)
+{
+    device_id = "00:00:00:00:00:00";
+}
+
+bool EiDeviceHost::start_sample_thread(void (*sample_read_cb)(void), float sample_interval_ms)
+{
+    this->sample_read_cb = sample_read_cb;
+    this->sample_interval_ms = sample_interval_ms;
+    sampling = true;
+
+    return true;
+}
+
+bool EiDeviceHost::stop_sample_thread(void)
+{
+    sampling = false;
+
+    return true;
+}
+
+bool EiDeviceHost::sample_tick(void)
+{
+    if (!sampling || sample_read_cb == nullptr) {
+        return false;
+    }
+
+    sample_read_cb();
+
+    return true;
+}
+
+bool EiDeviceHost::is_sampling(void)
+{
+    return sampling;
+}
+
+/**
+ * @brief      Data acquisition isn't part of the replay build, only inference is
+ */
+bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_start, uint32_t sample_size)
+{
+    (void)v_ptr_payload;
+    (void)ei_sample_start;
+    (void)sample_size;
+
+    ei_printf("ERR: Sampling to memory is not supported in the replay build\n");
+
+    return false;
+}
+
+/**
+ * @brief      There is no console to stop inference from, replay runs until the data ends
+ */
+char ei_getchar(void)
+{
+    return 0;
+}
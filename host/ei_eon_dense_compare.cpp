@@ -0,0 +1,159 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the specialized dense invoke of the compiled model (EI_CLASSIFIER_TFLITE_EON_DENSE)
+ * against the regular EON invoke: outputs must be bit for bit identical. Also reports the
+ * invoke time of both.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "tflite-model/tflite_learn_3_compiled.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/classifier/ei_aligned_malloc.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+
+#if EI_CLASSIFIER_TFLITE_EON_DENSE != 1
+#error "ei-eon-dense-compare needs EI_CLASSIFIER_TFLITE_EON_DENSE=1"
+#endif
+
+typedef TfLiteStatus (*invoke_fn_t)();
+
+/**
+ * @brief      Run invoke on every input, writing the outputs after each other
+ * @return     Time spent in invoke, in microseconds, or -1 on error
+ */
+static int64_t run_all(invoke_fn_t invoke, const std::vector<int8_t> &inputs, std::vector<int8_t> &outputs,
+    TfLiteTensor *input, TfLiteTensor *output)
+{
+    const size_t input_size = input->bytes;
+    const size_t output_size = output->bytes;
+    const size_t count = inputs.size() / input_size;
+    int64_t total_us = 0;
+
+    outputs.resize(count * output_size);
+
+    for (size_t ix = 0; ix < count; ix++) {
+        // the input tensor shares the arena with the other activations, write it every time
+        memcpy(input->data.int8, &inputs[ix * input_size], input_size);
+
+        uint64_t start_us = ei_read_timer_us();
+        if (invoke() != kTfLiteOk) {
+            return -1;
+        }
+        total_us += (int64_t)(ei_read_timer_us() - start_us);
+
+        memcpy(&outputs[ix * output_size], output->data.int8, output_size);
+    }
+
+    return total_us;
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = 100000;
+    unsigned int seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                count = (size_t)atoi(optarg);
+                break;
+            case 's':
+                seed = (unsigned int)atoi(optarg);
+                break;
+            default:
+                ei_printf("Usage: %s [-n <inputs>] [-s <seed>]\n", argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (tflite_learn_3_init(&ei_aligned_calloc) != kTfLiteOk) {
+        ei_printf("ERR: Failed to initialize the model\n");
+        return 1;
+    }
+
+    TfLiteTensor input;
+    TfLiteTensor output;
+    tflite_learn_3_input(0, &input);
+    tflite_learn_3_output(0, &output);
+
+    if (input.type != kTfLiteInt8 || output.type != kTfLiteInt8) {
+        ei_printf("ERR: Only int8 models are specialized\n");
+        return 1;
+    }
+
+    // uniformly random inputs, plus the two extremes
+    std::vector<int8_t> inputs((count + 2) * input.bytes);
+    srand(seed);
+    for (size_t ix = 0; ix < count * input.bytes; ix++) {
+        inputs[ix] = (int8_t)((rand() & 0xff) - 128);
+    }
+    memset(&inputs[count * input.bytes], -128, input.bytes);
+    memset(&inputs[(count + 1) * input.bytes], 127, input.bytes);
+
+    std::vector<int8_t> expected;
+    std::vector<int8_t> actual;
+    int64_t eon_us = run_all(&tflite_learn_3_invoke, inputs, expected, &input, &output);
+    int64_t dense_us = run_all(&tflite_learn_3_invoke_dense, inputs, actual, &input, &output);
+
+    tflite_learn_3_reset(&ei_aligned_free);
+
+    if (eon_us < 0 || dense_us < 0) {
+        ei_printf("ERR: Invoke failed\n");
+        return 1;
+    }
+
+    size_t mismatches = 0;
+    for (size_t ix = 0; ix < expected.size() / output.bytes; ix++) {
+        if (memcmp(&expected[ix * output.bytes], &actual[ix * output.bytes], output.bytes) != 0) {
+            if (mismatches++ < 10) {
+                ei_printf("Output of input %d differs\n", (int)ix);
+            }
+        }
+    }
+
+    const size_t total = count + 2;
+    ei_printf("Inputs: %d, mismatching outputs: %d\n", (int)total, (int)mismatches);
+    ei_printf("Invoke: EON %.3f us, dense %.3f us (%.2fx)\n",
+        (double)eon_us / total, (double)dense_us / total,
+        dense_us > 0 ? (double)eon_us / dense_us : 0.0);
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark of the power spectrum used by the spectral features, for FFT lengths 16 to
+ * 4096. "Uncached" releases the FFT plan before every call and takes the power from rfft's
+ * magnitudes, which is the cost of a power spectrum without the plan cache. "Cached" is
+ * numpy::power_spectrum with the plan kept between calls. Both results are compared.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "edge-impulse-sdk/dsp/numpy.hpp"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+
+using namespace ei;
+
+#if EIDSP_FFT_PLAN_CACHE_SIZE < 1
+#error "ei-fft-bench needs EIDSP_FFT_PLAN_CACHE_SIZE > 0"
+#endif
+
+/**
+ * @brief      Power spectrum without the plan cache: the plan and buffers are created and
+ *             released in the call, and the power is squared from the magnitudes
+ */
+static int power_spectrum_uncached(float *frame, size_t n_fft, float *out)
+{
+    const size_t out_size = n_fft / 2 + 1;
+
+    numpy::clear_fft_plans();
+    int r = numpy::rfft(frame, n_fft, out, out_size, n_fft);
+    numpy::clear_fft_plans();
+    if (r != EIDSP_OK) {
+        return r;
+    }
+    for (size_t ix = 0; ix < out_size; ix++) {
+        out[ix] = (1.0f / static_cast<float>(n_fft)) * (out[ix] * out[ix]);
+    }
+
+    return EIDSP_OK;
+}
+
+int main(int argc, char **argv)
+{
+    size_t points = 1 << 22;
+    unsigned int seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                points = (size_t)atoi(optarg);
+                break;
+            case 's':
+                seed = (unsigned int)atoi(optarg);
+                break;
+            default:
+                ei_printf("Usage: %s [-n <points per length>] [-s <seed>]\n", argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    srand(seed);
+    bool ok = true;
+
+    ei_printf("   n_fft  iterations  uncached us  cached us  speedup  max rel. diff\n");
+    for (size_t n_fft = 16; n_fft <= 4096; n_fft *= 2) {
+        const size_t iterations = points / n_fft > 0 ? points / n_fft : 1;
+        std::vector<float> frame(n_fft);
+        std::vector<float> expected(n_fft / 2 + 1);
+        std::vector<float> actual(n_fft / 2 + 1);
+
+        for (size_t ix = 0; ix < n_fft; ix++) {
+            frame[ix] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+        }
+
+        // both leave the frame untouched, so every iteration transforms the same data
+        uint64_t start_us = ei_read_timer_us();
+        for (size_t it = 0; it < iterations; it++) {
+            if (power_spectrum_uncached(frame.data(), n_fft, expected.data()) != EIDSP_OK) {
+                ok = false;
+            }
+        }
+        uint64_t uncached_us = ei_read_timer_us() - start_us;
+
+        start_us = ei_read_timer_us();
+        for (size_t it = 0; it < iterations; it++) {
+            if (numpy::power_spectrum(frame.data(), n_fft, actual.data(), actual.size(), n_fft) != EIDSP_OK) {
+                ok = false;
+            }
+        }
+        uint64_t cached_us = ei_read_timer_us() - start_us;
+        numpy::clear_fft_plans();
+
+        // relative to the largest bin, small bins lose precision in the sqrt round trip
+        float peak = 0.0f;
+        float max_diff = 0.0f;
+        for (size_t ix = 0; ix < expected.size(); ix++) {
+            peak = fmaxf(peak, expected[ix]);
+            max_diff = fmaxf(max_diff, fabsf(expected[ix] - actual[ix]));
+        }
+        const float rel_diff = peak > 0.0f ? max_diff / peak : max_diff;
+        if (rel_diff > 1e-5f) {
+            ok = false;
+        }
+
+        ei_printf("%8d  %10d  %11.3f  %9.3f  %6.2fx  %13.2e\n", (int)n_fft, (int)iterations,
+            (double)uncached_us / iterations, (double)cached_us / iterations,
+            cached_us > 0 ? (double)uncached_us / cached_us : 0.0, (double)rel_diff);
+    }
+
+    if (!ok) {
+        ei_printf("ERR: Power spectrum failed or differs\n");
+    }
+
+    return ok ? 0 : 1;
+}
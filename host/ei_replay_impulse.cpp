@@ -0,0 +1,313 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_replay_impulse.h"
+#include "ei_replay_sensor.h"
+#include "ei_device_host.h"
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_smooth.h"
+#include "firmware-sdk/ei_fusion.h"
+#include "firmware-sdk/ei_benchmark_lib.h"
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using replay_clock = chrono::steady_clock;
+
+/* Private variables ------------------------------------------------------- */
+static vector<float> samples;
+static size_t samples_per_inference;
+
+/* Private functions ------------------------------------------------------- */
+
+/**
+ * @brief Called for each single sample, the window is processed by the replay loop
+ */
+static bool samples_callback(const void *raw_sample, uint32_t raw_sample_size)
+{
+    EI_TRACE_ZONE("samples_callback");
+    const float *sample = (const float *)raw_sample;
+    size_t n_values = raw_sample_size / sizeof(float);
+
+    samples.insert(samples.end(), sample, sample + n_values);
+
+    return false;
+}
+
+static int samples_get_data(size_t offset, size_t length, float *out_ptr)
+{
+    memcpy(out_ptr, &samples[offset], length * sizeof(float));
+
+    return 0;
+}
+
+static uint64_t elapsed_us(replay_clock::time_point start, replay_clock::time_point end)
+{
+    return (uint64_t)chrono::duration_cast<chrono::microseconds>(end - start).count();
+}
+
+/**
+ * @brief Release what ei_replay_run_impulse set up, whether the replay ran or not
+ */
+static void replay_cleanup(const ei_replay_options_t *options, ei_classifier_event_t *events)
+{
+    if (options->continuous) {
+        run_classifier_deinit();
+    }
+    if (options->events) {
+        ei_classifier_event_free(events);
+    }
+}
+
+/* Public functions -------------------------------------------------------- */
+bool ei_replay_run_impulse(const ei_replay_options_t *options)
+{
+    EiDeviceHost *dev = static_cast<EiDeviceHost*>(EiDeviceInfo::get_device());
+    const char *axis_name = EI_CLASSIFIER_FUSION_AXES_STRING;
+    static ei_bench_histogram_t hist_dsp, hist_classification, hist_anomaly, hist_latency;
+
+    if (!ei_connect_fusion_list(axis_name, AXIS_FORMAT)) {
+        ei_printf("ERR: Failed to find axes '%s' in the recording\n", axis_name);
+        return false;
+    }
+
+    memset(&hist_dsp, 0, sizeof(hist_dsp));
+    memset(&hist_classification, 0, sizeof(hist_classification));
+    memset(&hist_anomaly, 0, sizeof(hist_anomaly));
+    memset(&hist_latency, 0, sizeof(hist_latency));
+
+    float interval_ms = ei_replay_sensor_interval_ms();
+    if (interval_ms != (float)EI_CLASSIFIER_INTERVAL_MS) {
+        ei_printf("WARN: Recording interval %.04fms differs from the model interval %.04fms\n",
+            interval_ms, (float)EI_CLASSIFIER_INTERVAL_MS);
+    }
+
+    if (options->continuous) {
+        samples_per_inference = EI_CLASSIFIER_SLICE_SIZE * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME;
+        run_classifier_init();
+    }
+    else {
+        samples_per_inference = EI_CLASSIFIER_RAW_SAMPLE_COUNT * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME;
+    }
+    samples.clear();
+    samples.reserve(samples_per_inference);
+
+#if EI_CLASSIFIER_FEATURE_CACHE
+    // copies of the impulse stand in for different impulses on the same sensor, the first
+    // one computes the features and the others take them from the cache
+    ei::ei_feature_cache_t cache;
+    vector<unique_ptr<ei_impulse_handle_t>> handles;
+    vector<ei_impulse_handle_t*> handle_ptrs;
+    vector<ei_impulse_result_t> results(options->impulses);
+    for (int ix = 0; ix < options->impulses; ix++) {
+        handles.emplace_back(new ei_impulse_handle_t(ei_default_impulse.impulse));
+        handle_ptrs.push_back(handles.back().get());
+    }
+#endif
+
+    // same defaults as CONFIG_EI_RESULT_EVENTS, in continuous mode the first results
+    // are skipped until the model window is filled
+    ei_classifier_event_t events;
+    size_t event_count = 0;
+    int events_skip = options->continuous ? EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW : 0;
+    if (options->events) {
+        ei_classifier_event_init(&events, 10, 7, 2);
+    }
+
+    if (!ei_fusion_sample_start(&samples_callback, interval_ms)) {
+        ei_printf("ERR: Failed to start sampling\n");
+        replay_cleanup(options, &events);
+        return false;
+    }
+
+    size_t sample_count = 0;
+    size_t late_samples = 0;
+    size_t windows = 0;
+    bool success = true;
+    const double tick_us = options->speed > 0.0f ? (interval_ms * 1000.0) / options->speed : 0.0;
+    replay_clock::time_point start = replay_clock::now();
+
+    while (!ei_replay_sensor_done()) {
+        if (tick_us > 0.0) {
+            replay_clock::time_point due = start + chrono::microseconds((int64_t)(sample_count * tick_us));
+            replay_clock::time_point now = replay_clock::now();
+            if (now < due) {
+                this_thread::sleep_until(due);
+            }
+            else if (elapsed_us(due, now) > tick_us) {
+                late_samples++;
+            }
+        }
+
+        dev->sample_tick();
+        sample_count++;
+
+        if (samples.size() < samples_per_inference) {
+            continue;
+        }
+
+        signal_t signal;
+        signal.total_length = samples_per_inference;
+        signal.get_data = &samples_get_data;
+
+        ei_impulse_result_t result = {};
+        EI_IMPULSE_ERROR ei_error;
+        replay_clock::time_point window_ready = replay_clock::now();
+
+        if (options->continuous) {
+            ei_error = run_classifier_continuous(&signal, &result, options->debug);
+        }
+#if EI_CLASSIFIER_FEATURE_CACHE
+        else if (options->impulses > 1) {
+            ei_error = run_impulses(handle_ptrs.data(), handle_ptrs.size(), &signal, sample_count,
+                results.data(), &cache, options->debug);
+            result = results[0];
+            for (size_t ix = 1; ix < results.size(); ix++) {
+                result.timing.dsp_us += results[ix].timing.dsp_us;
+                result.timing.classification_us += results[ix].timing.classification_us;
+                result.timing.anomaly_us += results[ix].timing.anomaly_us;
+            }
+        }
+#endif
+        else {
+            ei_error = run_classifier(&signal, &result, options->debug);
+        }
+
+        ei_bench_hist_add(&hist_latency, elapsed_us(window_ready, replay_clock::now()));
+        samples.clear();
+
+        if (ei_error != EI_IMPULSE_OK) {
+            ei_printf("ERR: Failed to run impulse (%d)\n", ei_error);
+            success = false;
+            break;
+        }
+
+        ei_bench_hist_add(&hist_dsp, result.timing.dsp_us);
+        ei_bench_hist_add(&hist_classification, result.timing.classification_us);
+        ei_bench_hist_add(&hist_anomaly, result.timing.anomaly_us);
+        windows++;
+
+        if (options->events) {
+            if (events_skip > 0) {
+                events_skip--;
+            }
+            else if (ei_classifier_event_update(&events, &result)) {
+                event_count++;
+                if (options->print_results) {
+                    float value = events.state >= 0 ? result.classification[events.state].value : 0.0f;
+                    float anomaly = 0.0f;
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+                    anomaly = result.anomaly;
+#endif
+                    ei_printf("Event: %s (%.5f, anomaly %.3f) at %.03f s\n",
+                        ei_classifier_event_label(&events, &result), value, anomaly,
+                        (sample_count * interval_ms) / 1000.0f);
+                }
+            }
+        }
+        else if (options->print_results) {
+            ei_printf("Window %d (%.03f s):\n", (int)windows, (sample_count * interval_ms) / 1000.0f);
+            display_results(&ei_default_impulse, &result);
+        }
+    }
+
+    double wall_s = elapsed_us(start, replay_clock::now()) / 1e6;
+    double data_s = (sample_count * interval_ms) / 1000.0;
+
+    dev->stop_sample_thread();
+
+    ei_printf("\nReplayed %d samples (%.03f s of data) in %.03f s, %.01fx real time\n",
+        (int)sample_count, data_s, wall_s, wall_s > 0.0 ? data_s / wall_s : 0.0);
+    ei_printf("Windows: %d, %.01f windows/s, late samples: %d\n",
+        (int)windows, wall_s > 0.0 ? windows / wall_s : 0.0, (int)late_samples);
+    if (options->events) {
+        ei_printf("Events: %d\n", (int)event_count);
+    }
+    if (windows > 0) {
+        ei_printf("Timing in ms\n");
+        ei_bench_hist_print("DSP", &hist_dsp);
+        ei_bench_hist_print("Classification", &hist_classification);
+        ei_bench_hist_print("Anomaly", &hist_anomaly);
+        ei_bench_hist_print("Latency", &hist_latency);
+    }
+#if EI_CLASSIFIER_FEATURE_CACHE
+    if (options->impulses > 1) {
+        ei_printf("Feature cache: %d hits, %d misses\n", (int)cache.get_hits(), (int)cache.get_misses());
+    }
+#endif
+
+    replay_cleanup(options, &events);
+
+    return success;
+}
+
+bool ei_replay_benchmark_impulse(uint32_t iterations)
+{
+    EiDeviceHost *dev = static_cast<EiDeviceHost*>(EiDeviceInfo::get_device());
+    const char *axis_name = EI_CLASSIFIER_FUSION_AXES_STRING;
+
+    if (!ei_connect_fusion_list(axis_name, AXIS_FORMAT)) {
+        ei_printf("ERR: Failed to find axes '%s' in the recording\n", axis_name);
+        return false;
+    }
+
+    samples_per_inference = EI_CLASSIFIER_RAW_SAMPLE_COUNT * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME;
+    samples.clear();
+    samples.reserve(samples_per_inference);
+
+    if (!ei_fusion_sample_start(&samples_callback, ei_replay_sensor_interval_ms())) {
+        ei_printf("ERR: Failed to start sampling\n");
+        return false;
+    }
+    while (!ei_replay_sensor_done() && samples.size() < samples_per_inference) {
+        dev->sample_tick();
+    }
+    dev->stop_sample_thread();
+
+    if (samples.size() < samples_per_inference) {
+        ei_printf("ERR: Recording is shorter than one window\n");
+        return false;
+    }
+
+    // the same window over and over, like AT+BENCHIMPULSE with static data
+    signal_t signal;
+    signal.total_length = samples_per_inference;
+    signal.get_data = &samples_get_data;
+
+    return ei_benchmark_impulse(&signal, iterations);
+}
@@ -0,0 +1,74 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_REPLAY_IMPULSE_H
+#define EI_REPLAY_IMPULSE_H
+
+#include <cstdint>
+
+typedef struct {
+    // replay speed relative to the recording, 0 runs as fast as possible
+    float speed;
+    bool continuous;
+    bool debug;
+    bool print_results;
+    // number of copies of the impulse run on every window with run_impulses (feature cache)
+    int impulses;
+    // print changes of the smoothed result only, like CONFIG_EI_RESULT_EVENTS on the device
+    bool events;
+} ei_replay_options_t;
+
+/* Function prototypes ----------------------------------------------------- */
+
+/**
+ * @brief      Run the impulse on the data of the "Replay" fusion sensor until the recording
+ *             ends, then print throughput and latency statistics
+ *
+ *             Samples go the same way as on the device: sensor read_data -> ei_fusion ->
+ *             sampler callback -> window -> run_classifier(_continuous). Windows don't overlap
+ *             and, unlike on the device, there is no pause between them in single shot mode.
+ *
+ * @return     false if the model axes don't match the recording or inference failed
+*/
+bool ei_replay_run_impulse(const ei_replay_options_t *options);
+
+/**
+ * @brief      Run the impulse iterations times on the first window of the recording with
+ *             ei_benchmark_impulse, the host counterpart of AT+BENCHIMPULSE
+ *
+ * @return     false if the recording is shorter than a window or the benchmark failed
+*/
+bool ei_replay_benchmark_impulse(uint32_t iterations);
+
+#endif /* EI_REPLAY_IMPULSE_H */
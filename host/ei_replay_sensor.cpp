@@ -0,0 +1,313 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_replay_sensor.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "QCBOR/inc/qcbor.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Private variables ------------------------------------------------------- */
+static vector<string> axis_names;
+static vector<string> axis_units;
+static vector<float> frames;        // frames.size() == frame_count * axis_names.size()
+static size_t frame_count = 0;
+static size_t frame_ix = 0;
+static int loops_left = 0;
+static float interval_ms = 0.0f;
+
+/* Private functions ------------------------------------------------------- */
+static bool ends_with(const string &str, const char *suffix)
+{
+    size_t len = strlen(suffix);
+
+    return str.size() >= len && str.compare(str.size() - len, len, suffix) == 0;
+}
+
+static string trim(const string &str)
+{
+    size_t start = str.find_first_not_of(" \t\r\n\"");
+    size_t end = str.find_last_not_of(" \t\r\n\"");
+
+    return (start == string::npos) ? "" : str.substr(start, end - start + 1);
+}
+
+static bool load_csv(const char *path)
+{
+    ifstream file(path);
+    string line;
+
+    if (!file.is_open() || !getline(file, line)) {
+        return false;
+    }
+
+    vector<string> columns;
+    stringstream header(line);
+    string column;
+    while (getline(header, column, ',')) {
+        columns.push_back(trim(column));
+    }
+
+    bool has_timestamp = !columns.empty() && columns[0] == "timestamp";
+    for (size_t ix = has_timestamp ? 1 : 0; ix < columns.size(); ix++) {
+        axis_names.push_back(columns[ix]);
+        axis_units.push_back("N/A");
+    }
+
+    double first_timestamp = 0.0;
+    double second_timestamp = 0.0;
+
+    while (getline(file, line)) {
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        stringstream row(line);
+        string value;
+        size_t col = 0;
+        while (getline(row, value, ',')) {
+            double number = strtod(value.c_str(), nullptr);
+            if (has_timestamp && col == 0) {
+                if (frame_count == 0) {
+                    first_timestamp = number;
+                }
+                else if (frame_count == 1) {
+                    second_timestamp = number;
+                }
+            }
+            else {
+                frames.push_back((float)number);
+            }
+            col++;
+        }
+
+        if (col != columns.size()) {
+            ei_printf("ERR: Row %d has %d columns, expected %d\n", (int)frame_count + 2, (int)col, (int)columns.size());
+            return false;
+        }
+        frame_count++;
+    }
+
+    if (has_timestamp && frame_count > 1) {
+        interval_ms = (float)(second_timestamp - first_timestamp);
+    }
+
+    return true;
+}
+
+static bool label_is(const QCBORItem &item, const char *label)
+{
+    return item.uLabelType == QCBOR_TYPE_TEXT_STRING &&
+           item.label.string.len == strlen(label) &&
+           memcmp(item.label.string.ptr, label, item.label.string.len) == 0;
+}
+
+static bool item_to_number(const QCBORItem &item, double *number)
+{
+    switch (item.uDataType) {
+        case QCBOR_TYPE_INT64:
+            *number = (double)item.val.int64;
+            return true;
+        case QCBOR_TYPE_UINT64:
+            *number = (double)item.val.uint64;
+            return true;
+        case QCBOR_TYPE_FLOAT:
+        case QCBOR_TYPE_DOUBLE:
+            *number = item.val.dfnum;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool load_cbor(const char *path)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    vector<uint8_t> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    QCBORDecodeContext ctx;
+    QCBORItem item;
+    UsefulBufC buffer = { data.data(), data.size() };
+    int sensors_level = -1;     // nesting level of the "sensors" array
+    int values_level = -1;      // nesting level of the "values" array
+    string current_name;
+
+    QCBORDecode_Init(&ctx, buffer, QCBOR_DECODE_MODE_NORMAL);
+
+    while (QCBORDecode_GetNext(&ctx, &item) == QCBOR_SUCCESS) {
+        double number;
+
+        if (values_level >= 0 && item.uNestingLevel > values_level) {
+            // frames are arrays inside of "values", one number per axis
+            if (item.uNestingLevel == values_level + 2 && item_to_number(item, &number)) {
+                frames.push_back((float)number);
+                if (item.uNextNestLevel < item.uNestingLevel) {
+                    frame_count++;
+                }
+            }
+            continue;
+        }
+        values_level = -1;
+
+        if (sensors_level >= 0 && item.uNestingLevel > sensors_level) {
+            // "sensors" is an array of { "name": ..., "units": ... } maps
+            if (item.uDataType == QCBOR_TYPE_TEXT_STRING) {
+                string str((const char *)item.val.string.ptr, item.val.string.len);
+                if (label_is(item, "name")) {
+                    axis_names.push_back(str);
+                }
+                else if (label_is(item, "units")) {
+                    axis_units.push_back(str);
+                }
+            }
+            continue;
+        }
+        sensors_level = -1;
+
+        if (label_is(item, "interval_ms") && item_to_number(item, &number)) {
+            interval_ms = (float)number;
+        }
+        else if (label_is(item, "sensors") && item.uDataType == QCBOR_TYPE_ARRAY) {
+            sensors_level = item.uNestingLevel;
+        }
+        else if (label_is(item, "values") && item.uDataType == QCBOR_TYPE_ARRAY) {
+            values_level = item.uNestingLevel;
+        }
+    }
+
+    axis_units.resize(axis_names.size(), "N/A");
+
+    return true;
+}
+
+/* Public functions -------------------------------------------------------- */
+bool ei_replay_sensor_load(const char *path, float default_interval_ms, int loops)
+{
+    string file_name(path);
+    bool loaded;
+
+    axis_names.clear();
+    axis_units.clear();
+    frames.clear();
+    frame_count = 0;
+    frame_ix = 0;
+    interval_ms = 0.0f;
+    loops_left = loops;
+
+    if (ends_with(file_name, ".csv")) {
+        loaded = load_csv(path);
+    }
+    else if (ends_with(file_name, ".cbor")) {
+        loaded = load_cbor(path);
+    }
+    else {
+        ei_printf("ERR: Unknown file format, expected .csv or .cbor\n");
+        return false;
+    }
+
+    if (!loaded) {
+        ei_printf("ERR: Failed to read %s\n", path);
+        return false;
+    }
+
+    if (axis_names.empty() || axis_names.size() > EI_MAX_SENSOR_AXES) {
+        ei_printf("ERR: Recording has %d axes, expected 1 to %d\n", (int)axis_names.size(), EI_MAX_SENSOR_AXES);
+        return false;
+    }
+
+    if (frame_count == 0 || frames.size() != frame_count * axis_names.size()) {
+        ei_printf("ERR: Recording has no or incomplete frames\n");
+        return false;
+    }
+
+    if (interval_ms <= 0.0f) {
+        interval_ms = default_interval_ms;
+    }
+
+    ei_device_fusion_sensor_t sensor = { };
+    sensor.name = "Replay";
+    sensor.num_axis = (int)axis_names.size();
+    sensor.frequencies[0] = 1000.0f / interval_ms;
+    for (size_t ix = 0; ix < axis_names.size(); ix++) {
+        sensor.sensors[ix].name = axis_names[ix].c_str();
+        sensor.sensors[ix].units = axis_units[ix].c_str();
+    }
+    sensor.read_data = &ei_replay_sensor_read_data;
+
+    return ei_add_sensor_to_fusion_list(sensor);
+}
+
+float *ei_replay_sensor_read_data(int n_samples)
+{
+    (void)n_samples;
+
+    if (ei_replay_sensor_done()) {
+        return NULL;
+    }
+
+    float *frame = &frames[frame_ix * axis_names.size()];
+
+    if (++frame_ix == frame_count) {
+        frame_ix = 0;
+        loops_left--;
+    }
+
+    return frame;
+}
+
+bool ei_replay_sensor_done(void)
+{
+    return loops_left <= 0;
+}
+
+float ei_replay_sensor_interval_ms(void)
+{
+    return interval_ms;
+}
+
+size_t ei_replay_sensor_frames(void)
+{
+    return frame_count;
+}
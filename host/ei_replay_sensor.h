@@ -0,0 +1,70 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_REPLAY_SENSOR_H
+#define EI_REPLAY_SENSOR_H
+
+/* Include ----------------------------------------------------------------- */
+#include "firmware-sdk/ei_fusion.h"
+#include <cstddef>
+
+/* Function prototypes ----------------------------------------------------- */
+
+/**
+ * @brief      Load recorded data and register it as a fusion sensor ("Replay"), axes
+ *             are named after the recording so they can be matched with the model axes
+ *
+ *             Two formats are supported:
+ *             - CSV with a header row, an optional first "timestamp" column (ms) and one
+ *               column per axis
+ *             - Edge Impulse data acquisition CBOR (as produced by sensor_aq)
+ *
+ * @param[in]  path                 File to load, format is chosen by extension (.csv/.cbor)
+ * @param[in]  default_interval_ms  Sample interval used if the file doesn't define one
+ * @param[in]  loops                How many times the recording is replayed
+ * @return     false if the file couldn't be read or parsed
+*/
+bool ei_replay_sensor_load(const char *path, float default_interval_ms, int loops);
+
+/**
+ * @brief      Read the next frame of the recording (fusion read_data callback)
+ * @return     Pointer to the values of all axes, NULL once the recording ended
+*/
+float *ei_replay_sensor_read_data(int n_samples);
+
+bool ei_replay_sensor_done(void);
+float ei_replay_sensor_interval_ms(void);
+size_t ei_replay_sensor_frames(void);
+
+#endif /* EI_REPLAY_SENSOR_H */
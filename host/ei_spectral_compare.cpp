@@ -0,0 +1,243 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compares the fixed point spectral analysis features (EI_CLASSIFIER_SPECTRAL_QUANTIZED)
+ * against the float implementation on a recording: int8 feature error in LSB after
+ * quantization, and how often the classification result changes.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_replay_sensor.h"
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+
+#if EI_CLASSIFIER_SPECTRAL_QUANTIZED != 1 || EI_CLASSIFIER_QUANTIZATION_ENABLED != 1 || EI_CLASSIFIER_COMPILED != 1
+#error "ei-spectral-compare needs a quantized EON model and EI_CLASSIFIER_SPECTRAL_QUANTIZED=1"
+#endif
+
+static std::vector<float> window_buffer;
+
+static int get_window_data(size_t offset, size_t length, float *out_ptr)
+{
+    memcpy(out_ptr, window_buffer.data() + offset, length * sizeof(float));
+    return 0;
+}
+
+static void print_usage(const char *name)
+{
+    ei_printf("Usage: %s [options] <recording.csv|recording.cbor>\n", name);
+    ei_printf("  -i <ms>      sample interval if the recording doesn't define one (default: model interval)\n");
+    ei_printf("  -w <frames>  frames between windows (default: a quarter window)\n");
+}
+
+static bool get_input_quantization(const ei_impulse_t *impulse, float *scale, int32_t *zero_point)
+{
+    ei_learning_block_config_tflite_graph_t *block_config =
+        (ei_learning_block_config_tflite_graph_t *)impulse->learning_blocks[0].config;
+    ei_config_tflite_eon_graph_t *graph_config = (ei_config_tflite_eon_graph_t *)block_config->graph_config;
+    TfLiteTensor input;
+
+    if (graph_config->model_init(ei_aligned_calloc) != kTfLiteOk) {
+        return false;
+    }
+    bool ok = graph_config->model_input(0, &input) == kTfLiteOk && input.type == kTfLiteInt8;
+    *scale = input.params.scale;
+    *zero_point = input.params.zero_point;
+    graph_config->model_reset(ei_aligned_free);
+
+    return ok;
+}
+
+static size_t top_label(const ei_impulse_result_t *result)
+{
+    size_t top = 0;
+    for (size_t ix = 1; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+        if (result->classification[ix].value > result->classification[top].value) {
+            top = ix;
+        }
+    }
+    return top;
+}
+
+int main(int argc, char **argv)
+{
+    float interval_ms = (float)EI_CLASSIFIER_INTERVAL_MS;
+    size_t stride = EI_CLASSIFIER_RAW_SAMPLE_COUNT / 4;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "i:w:h")) != -1) {
+        switch (opt) {
+            case 'i':
+                interval_ms = strtof(optarg, nullptr);
+                break;
+            case 'w':
+                stride = (size_t)atoi(optarg);
+                break;
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind != argc - 1 || interval_ms <= 0.0f || stride == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!ei_replay_sensor_load(argv[optind], interval_ms, 1)) {
+        return 1;
+    }
+
+    ei_impulse_handle_t *handle = &ei_default_impulse;
+    const ei_impulse_t *impulse = handle->impulse;
+
+    if (can_run_classifier_spectral_quantized(impulse) != EI_IMPULSE_OK) {
+        ei_printf("ERR: The impulse can't use the fixed point spectral features\n");
+        return 1;
+    }
+
+    float scale;
+    int32_t zero_point;
+    if (!get_input_quantization(impulse, &scale, &zero_point)) {
+        ei_printf("ERR: Failed to read the input quantization of the model\n");
+        return 1;
+    }
+
+    // recording axes are taken in order, they should match the model axes
+    std::vector<float> frames;
+    size_t frame_count = 0;
+    while (!ei_replay_sensor_done()) {
+        float *frame = ei_replay_sensor_read_data(1);
+        frames.insert(frames.end(), frame, frame + EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
+        frame_count++;
+    }
+
+    if (frame_count < EI_CLASSIFIER_RAW_SAMPLE_COUNT) {
+        ei_printf("ERR: Recording is shorter than one window (%d frames)\n", (int)frame_count);
+        return 1;
+    }
+
+    const ei_model_dsp_t &dsp = impulse->dsp_blocks[0];
+    const size_t n_features = dsp.n_output_features;
+    const uint32_t block_num = impulse->dsp_blocks_size + impulse->learning_blocks_size;
+
+    ei::matrix_t float_features(1, n_features);
+    ei::matrix_t fixed_features(1, n_features);
+    ei::matrix_i8_t quantized_features(1, n_features);
+    std::unique_ptr<ei_feature_t[]> fmatrix(new ei_feature_t[block_num]);
+
+    size_t windows = 0;
+    size_t exact = 0;
+    size_t label_mismatch = 0;
+    int max_lsb = 0;
+    double sum_lsb = 0;
+    float max_prob_diff = 0.0f;
+    float max_anomaly_diff = 0.0f;
+    std::vector<int> max_lsb_per_feature(n_features, 0);
+
+    window_buffer.resize(EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
+
+    for (size_t start = 0; start + EI_CLASSIFIER_RAW_SAMPLE_COUNT <= frame_count; start += stride) {
+        memcpy(window_buffer.data(), &frames[start * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME],
+            EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE * sizeof(float));
+
+        signal_t signal;
+        signal.total_length = EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE;
+        signal.get_data = &get_window_data;
+
+        // float reference, quantized the way the input tensor is filled
+        if (extract_spectral_analysis_features(&signal, &float_features, dsp.config, impulse->frequency) != EIDSP_OK
+            || extract_spectral_analysis_features_quantized(&signal, &quantized_features, dsp.config, scale,
+                zero_point, impulse->frequency, &fixed_features) != EIDSP_OK) {
+            ei_printf("ERR: Failed to extract features of window %d\n", (int)windows);
+            return 1;
+        }
+
+        for (size_t ix = 0; ix < n_features; ix++) {
+            int ref = (int)roundf(float_features.buffer[ix] / scale) + zero_point;
+            ref = ref < -128 ? -128 : (ref > 127 ? 127 : ref);
+            int lsb = abs(ref - quantized_features.buffer[ix]);
+            exact += lsb == 0;
+            sum_lsb += lsb;
+            max_lsb = lsb > max_lsb ? lsb : max_lsb;
+            max_lsb_per_feature[ix] = lsb > max_lsb_per_feature[ix] ? lsb : max_lsb_per_feature[ix];
+        }
+
+        ei_impulse_result_t float_result;
+        ei_impulse_result_t fixed_result;
+
+        memset(&float_result, 0, sizeof(float_result));
+        memset(fmatrix.get(), 0, sizeof(ei_feature_t) * block_num);
+        fmatrix[0].matrix = &float_features;
+        fmatrix[0].blockId = dsp.blockId;
+
+        if (run_inference(handle, fmatrix.get(), &float_result, false) != EI_IMPULSE_OK
+            || run_classifier_spectral_quantized(impulse, &signal, &fixed_result, false) != EI_IMPULSE_OK) {
+            ei_printf("ERR: Failed to classify window %d\n", (int)windows);
+            return 1;
+        }
+
+        label_mismatch += top_label(&float_result) != top_label(&fixed_result);
+        for (size_t ix = 0; ix < EI_CLASSIFIER_LABEL_COUNT; ix++) {
+            float diff = fabsf(float_result.classification[ix].value - fixed_result.classification[ix].value);
+            max_prob_diff = diff > max_prob_diff ? diff : max_prob_diff;
+        }
+        float anomaly_diff = fabsf(float_result.anomaly - fixed_result.anomaly);
+        max_anomaly_diff = anomaly_diff > max_anomaly_diff ? anomaly_diff : max_anomaly_diff;
+
+        windows++;
+    }
+
+    ei_printf("Windows: %d, features per window: %d, input scale %f, zero point %d\n",
+        (int)windows, (int)n_features, scale, (int)zero_point);
+    ei_printf("Features: %.2f%% exact, mean error %.3f LSB, max error %d LSB\n",
+        100.0 * exact / (windows * n_features), sum_lsb / (windows * n_features), max_lsb);
+    ei_printf("Max error per feature (LSB):");
+    for (size_t ix = 0; ix < n_features; ix++) {
+        ei_printf(" %d", max_lsb_per_feature[ix]);
+    }
+    ei_printf("\n");
+    ei_printf("Top label differs in %d of %d windows, max probability difference %f\n",
+        (int)label_mismatch, (int)windows, max_prob_diff);
+    ei_printf("Max anomaly score difference: %f\n", max_anomaly_diff);
+
+    return 0;
+}
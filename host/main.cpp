@@ -0,0 +1,214 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_replay_impulse.h"
+#include "ei_replay_sensor.h"
+#include "model-parameters/model_metadata.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "firmware-sdk/ei_trace_lib.h"
+#include "firmware-sdk/ei_classify_buffer_lib.h"
+#include "firmware-sdk/ei_device_info_lib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <unistd.h>
+
+static void print_usage(const char *name)
+{
+    ei_printf("Usage: %s [options] <recording.csv|recording.cbor>\n", name);
+    ei_printf("  -s <speed>  replay speed, 1 is real time (default), 0 as fast as possible\n");
+    ei_printf("  -l <loops>  replay the recording this many times (default 1)\n");
+    ei_printf("  -i <ms>     sample interval if the recording doesn't define one (default: model interval)\n");
+    ei_printf("  -c          continuous inference\n");
+    ei_printf("  -d          run the classifier in debug mode\n");
+    ei_printf("  -q          don't print results of every window\n");
+    ei_printf("  -e          print only changes of the smoothed result (CONFIG_EI_RESULT_EVENTS)\n");
+    ei_printf("  -b <stride> copy the .cbor recording to the sample memory and classify it like\n");
+    ei_printf("              AT+CLASSIFYBUFFER, moving the window stride frames at a time\n");
+    ei_printf("  -B <count>  run the impulse count times on the first window and print timing\n");
+    ei_printf("              histograms like AT+BENCHIMPULSE\n");
+#if EI_TRACE_ENABLED
+    ei_printf("  -t <file>   write a Chrome trace of the replay to file\n");
+#endif
+#if EI_CLASSIFIER_FEATURE_CACHE
+    ei_printf("  -m <count>  run the impulse count times per window, sharing the DSP features\n");
+#endif
+}
+
+#if EI_TRACE_ENABLED
+static bool write_trace(const char *path)
+{
+    // ei_printf goes to stdout, so point stdout to the trace file
+    fflush(stdout);
+    if (freopen(path, "w", stdout) == nullptr) {
+        fprintf(stderr, "ERR: Failed to open %s\n", path);
+        return false;
+    }
+    ei_trace_print_chrome_json();
+    fclose(stdout);
+
+    return true;
+}
+#endif
+
+/**
+ * @brief      Put a recording in the sample memory, where the sampler would have written it,
+ *             and run AT+CLASSIFYBUFFER on it
+ */
+static bool classify_from_memory(const char *path, uint32_t stride, bool print_windows)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        ei_printf("ERR: Failed to open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    EiDeviceMemory *mem = EiDeviceInfo::get_device()->get_memory();
+    if (data.size() > mem->get_available_sample_bytes()) {
+        ei_printf("ERR: Recording is %d bytes, the sample memory only holds %d\n",
+            (int)data.size(), (int)mem->get_available_sample_bytes());
+        return false;
+    }
+    if (mem->write_sample_data(data.data(), 0, data.size()) != data.size()) {
+        ei_printf("ERR: Failed to write the recording to the sample memory\n");
+        return false;
+    }
+
+    return ei_classify_buffer(mem, 0, data.size(), stride, print_windows);
+}
+
+int main(int argc, char **argv)
+{
+    ei_replay_options_t options = { 1.0f, false, false, true, 1, false };
+    float interval_ms = (float)EI_CLASSIFIER_INTERVAL_MS;
+    int loops = 1;
+    const char *trace_path = nullptr;
+    int classify_stride = 0;
+    int bench_iterations = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:l:i:cdqeb:B:t:m:h")) != -1) {
+        switch (opt) {
+            case 's':
+                options.speed = strtof(optarg, nullptr);
+                break;
+            case 'l':
+                loops = atoi(optarg);
+                break;
+            case 'i':
+                interval_ms = strtof(optarg, nullptr);
+                break;
+            case 'c':
+                options.continuous = true;
+                break;
+            case 'd':
+                options.debug = true;
+                break;
+            case 'q':
+                options.print_results = false;
+                break;
+            case 'e':
+                options.events = true;
+                break;
+            case 'b':
+                classify_stride = atoi(optarg);
+                if (classify_stride < 1) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'B':
+                bench_iterations = atoi(optarg);
+                if (bench_iterations < 1) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+#if EI_TRACE_ENABLED
+            case 't':
+                trace_path = optarg;
+                break;
+#endif
+#if EI_CLASSIFIER_FEATURE_CACHE
+            case 'm':
+                options.impulses = atoi(optarg);
+                break;
+#endif
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (optind != argc - 1 || loops < 1 || interval_ms <= 0.0f || options.speed < 0.0f || options.impulses < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (classify_stride > 0) {
+        return classify_from_memory(argv[optind], (uint32_t)classify_stride, options.print_results) ? 0 : 1;
+    }
+
+    if (!ei_replay_sensor_load(argv[optind], interval_ms, loops)) {
+        return 1;
+    }
+
+    if (bench_iterations > 0) {
+        return ei_replay_benchmark_impulse((uint32_t)bench_iterations) ? 0 : 1;
+    }
+
+    ei_printf("Replaying %d frames at %.04fms interval, %d time(s)\n",
+        (int)ei_replay_sensor_frames(), ei_replay_sensor_interval_ms(), loops);
+
+#if EI_TRACE_ENABLED
+    ei_trace_init();
+#endif
+
+    bool ok = ei_replay_run_impulse(&options);
+
+#if EI_TRACE_ENABLED
+    if (trace_path != nullptr && !write_trace(trace_path)) {
+        ok = false;
+    }
+#else
+    (void)trace_path;
+#endif
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Bucketing of the benchmark latency histogram (firmware-sdk/ei_benchmark_lib.cpp) at the
+ * bucket boundaries, up to and past the largest value that gets its own bucket.
+ */
+
+#include "ei_benchmark_lib.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_types.h"
+#include <cstdio>
+#include <cstring>
+
+#define HIST_LIMIT      ((uint64_t)1 << EI_BENCH_HIST_MAX_BITS)
+
+// ei_benchmark_impulse isn't run here, these only satisfy its references
+extern "C" EI_IMPULSE_ERROR run_classifier(ei::signal_t *signal, ei_impulse_result_t *result, bool debug)
+{
+    (void)signal;
+    (void)result;
+    (void)debug;
+    return EI_IMPULSE_OK;
+}
+
+bool ei_user_invoke_stop_lib(void)
+{
+    return false;
+}
+
+/**
+ * @brief      Add value and a larger one, the median must be value rounded up by at most
+ *             one eighth, or the maximum past the histogram range
+ */
+static bool check_value(uint64_t value)
+{
+    ei_bench_histogram_t hist;
+    memset(&hist, 0, sizeof(hist));
+
+    ei_bench_hist_add(&hist, value);
+    ei_bench_hist_add(&hist, UINT64_MAX);
+
+    uint32_t counted = 0;
+    for (size_t ix = 0; ix < EI_BENCH_HIST_BUCKETS; ix++) {
+        counted += hist.counts[ix];
+    }
+    // a bucket index past the array ends up in the fields after it
+    if (hist.total != 2 || counted != 2 || hist.max != UINT64_MAX) {
+        printf("FAIL: %llu: total %u, counted %u\n", (unsigned long long)value, hist.total, counted);
+        return false;
+    }
+    if (value >= HIST_LIMIT && hist.counts[EI_BENCH_HIST_BUCKETS - 1] != 2) {
+        printf("FAIL: %llu isn't in the last bucket\n", (unsigned long long)value);
+        return false;
+    }
+
+    uint64_t median = ei_bench_hist_percentile(&hist, 0.5f);
+    uint64_t expected_max = value < HIST_LIMIT ? value + value / 8 : UINT64_MAX;
+    if (median < value || median > expected_max) {
+        printf("FAIL: %llu: median %llu\n", (unsigned long long)value, (unsigned long long)median);
+        return false;
+    }
+
+    return true;
+}
+
+int main(void)
+{
+    size_t checked = 0;
+
+    for (uint64_t value = 0; value < 64; value++) {
+        if (!check_value(value)) {
+            return 1;
+        }
+        checked++;
+    }
+    for (int bit = 3; bit < 64; bit++) {
+        const uint64_t power = (uint64_t)1 << bit;
+        const uint64_t values[] = { power - 1, power, power + 1, power + power / 2, power * 2 - 1 };
+        for (uint64_t value : values) {
+            if (!check_value(value)) {
+                return 1;
+            }
+            checked++;
+        }
+    }
+
+    printf("OK, %d values\n", (int)checked);
+    return 0;
+}
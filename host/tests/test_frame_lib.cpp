@@ -0,0 +1,289 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Loopback test of the framed transfer (firmware-sdk/ei_frame_lib.cpp). ei_frame_send and
+ * ei_frame_receive run on two threads, connected by a link that drops, corrupts and
+ * reorders the frames written in either direction. The received data must match what was
+ * sent, and when data frames were damaged the sender has to have retransmitted frames.
+ */
+
+#include "ei_frame_lib.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define TRANSFER_SIZE       (50 * EI_FRAME_MAX_PAYLOAD + 17)
+#define REORDER_HOLD_READS  100
+
+typedef struct {
+    const char *name;
+    // chances in percent, per frame
+    int drop;
+    int corrupt;
+    int reorder;
+} scenario_t;
+
+/**
+ * @brief One direction of the link. Writes are whole frames (ei_frame_lib writes one
+ * encoded frame at a time), which is the unit that gets dropped, corrupted or reordered.
+ */
+class Link {
+public:
+    void configure(const scenario_t *scenario, unsigned int seed)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bytes.clear();
+        held.clear();
+        held_reads = 0;
+        impair = scenario;
+        rng.seed(seed);
+        frames = 0;
+        damaged = 0;
+    }
+
+    void write(const uint8_t *data, size_t length)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<uint8_t> frame(data, data + length);
+
+        // the lone delimiter starting a transfer isn't impaired
+        if (length > 1) {
+            frames++;
+            if (chance(impair->drop)) {
+                damaged++;
+                return;
+            }
+            if (chance(impair->corrupt)) {
+                // any byte but the delimiter, one bit
+                frame[rng() % (length - 1)] ^= (uint8_t)(1 << (rng() % 8));
+                damaged++;
+            }
+            if (held.empty() && chance(impair->reorder)) {
+                held = frame;
+                held_reads = 0;
+                return;
+            }
+        }
+
+        bytes.insert(bytes.end(), frame.begin(), frame.end());
+        if (!held.empty()) {
+            // overtaken by this frame
+            damaged++;
+            release_held();
+        }
+    }
+
+    size_t read(uint8_t *data, size_t length)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // a held frame is let through after the next frame, or after a while if none comes
+        if (bytes.empty() && !held.empty() && ++held_reads >= REORDER_HOLD_READS) {
+            release_held();
+        }
+
+        size_t count = 0;
+        while (count < length && !bytes.empty()) {
+            data[count++] = bytes.front();
+            bytes.pop_front();
+        }
+        return count;
+    }
+
+    size_t get_frames()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return frames;
+    }
+
+    /**
+     * @brief Frames that were dropped, corrupted or overtaken, a late frame that wasn't
+     * overtaken still arrives in order
+     */
+    size_t get_damaged()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return damaged;
+    }
+
+private:
+    bool chance(int percent)
+    {
+        return (int)(rng() % 100) < percent;
+    }
+
+    void release_held()
+    {
+        bytes.insert(bytes.end(), held.begin(), held.end());
+        held.clear();
+    }
+
+    std::mutex mutex;
+    std::deque<uint8_t> bytes;
+    std::vector<uint8_t> held;
+    int held_reads;
+    const scenario_t *impair;
+    std::minstd_rand rng;
+    size_t frames;
+    size_t damaged;
+};
+
+static Link to_receiver;
+static Link to_sender;
+
+static void sender_write(const uint8_t *data, size_t length)
+{
+    to_receiver.write(data, length);
+}
+
+static size_t sender_read(uint8_t *data, size_t length)
+{
+    size_t count = to_sender.read(data, length);
+    if (count == 0) {
+        std::this_thread::yield();
+    }
+    return count;
+}
+
+static void receiver_write(const uint8_t *data, size_t length)
+{
+    to_sender.write(data, length);
+}
+
+static size_t receiver_read(uint8_t *data, size_t length)
+{
+    size_t count = to_receiver.read(data, length);
+    if (count == 0) {
+        std::this_thread::yield();
+    }
+    return count;
+}
+
+static const ei_frame_io_t sender_io = { sender_write, sender_read, nullptr };
+static const ei_frame_io_t receiver_io = { receiver_write, receiver_read, nullptr };
+
+static bool source(void *ctx, size_t offset, uint8_t *data, size_t length)
+{
+    const std::vector<uint8_t> *input = (const std::vector<uint8_t> *)ctx;
+    memcpy(data, &(*input)[offset], length);
+    return true;
+}
+
+/**
+ * @return number of damaged data frames, or -1 if the transfer failed
+ */
+static long run_scenario(const scenario_t *scenario, unsigned int seed)
+{
+    std::vector<uint8_t> input(TRANSFER_SIZE);
+    std::vector<uint8_t> output(TRANSFER_SIZE, 0);
+    std::minstd_rand rng(seed);
+
+    // plenty of zeros, so COBS has something to do
+    for (size_t ix = 0; ix < input.size(); ix++) {
+        input[ix] = rng() % 4 == 0 ? 0x00 : (uint8_t)rng();
+    }
+
+    to_receiver.configure(scenario, seed * 2);
+    to_sender.configure(scenario, seed * 2 + 1);
+
+    std::atomic<bool> received(false);
+    std::thread receiver([&]() {
+        received.store(ei_frame_receive(&receiver_io, output.data(), output.size()));
+    });
+    bool sent = ei_frame_send(&sender_io, input.size(), source, &input);
+    receiver.join();
+
+    const size_t frames_total = (TRANSFER_SIZE + EI_FRAME_MAX_PAYLOAD - 1) / EI_FRAME_MAX_PAYLOAD;
+    const size_t frames_sent = to_receiver.get_frames();
+    const size_t frames_damaged = to_receiver.get_damaged();
+    const bool impaired = scenario->drop > 0 || scenario->corrupt > 0 || scenario->reorder > 0;
+
+    printf("%-10s seed %u: %d data frames for %d (%d damaged), %d ACK/NAK frames (%d damaged)\n",
+        scenario->name, seed, (int)frames_sent, (int)frames_total, (int)frames_damaged,
+        (int)to_sender.get_frames(), (int)to_sender.get_damaged());
+
+    if (!sent || !received.load()) {
+        printf("FAIL: transfer failed (send %d, receive %d)\n", sent, received.load());
+        return -1;
+    }
+    if (input != output) {
+        printf("FAIL: received data differs\n");
+        return -1;
+    }
+    if (frames_sent < frames_total || (!impaired && frames_sent != frames_total)) {
+        printf("FAIL: expected %d data frames without retransmissions\n", (int)frames_total);
+        return -1;
+    }
+    if (frames_damaged > 0 && frames_sent == frames_total) {
+        printf("FAIL: damaged frames weren't retransmitted\n");
+        return -1;
+    }
+
+    return (long)frames_damaged;
+}
+
+int main(void)
+{
+    static const scenario_t scenarios[] = {
+        { "clean", 0, 0, 0 },
+        { "dropped", 10, 0, 0 },
+        { "corrupted", 0, 10, 0 },
+        { "reordered", 0, 0, 10 },
+        { "all", 5, 5, 5 },
+    };
+
+    for (const scenario_t &scenario : scenarios) {
+        long damaged = 0;
+        for (unsigned int seed = 1; seed <= 3; seed++) {
+            long res = run_scenario(&scenario, seed);
+            if (res < 0) {
+                return 1;
+            }
+            damaged += res;
+        }
+        if (scenario.drop + scenario.corrupt + scenario.reorder > 0 && damaged == 0) {
+            printf("FAIL: no data frame of %s was damaged\n", scenario.name);
+            return 1;
+        }
+    }
+
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Two thread stress test of the sampler -> inference ring (src/inference/ei_samples_ring.h).
+ * The producer pushes samples of AXES values numbered in sequence, the consumer takes
+ * windows the way the inference thread does and checks that no value is lost, duplicated
+ * or torn. The ring size isn't a multiple of the sample size, so samples wrap around.
+ */
+
+#include "ei_samples_ring.h"
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#define AXES            3
+#define RING_SIZE       64
+#define WINDOW_VALUES   (10 * AXES)
+#define SAMPLES         1000000
+
+static EiSamplesRing<RING_SIZE> ring;
+static std::atomic<bool> producer_done;
+
+static void producer(bool retry)
+{
+    float sample[AXES];
+
+    for (uint32_t ix = 0; ix < SAMPLES; ix++) {
+        for (int axis = 0; axis < AXES; axis++) {
+            sample[axis] = (float)(ix * AXES + axis);
+        }
+        while (ring.push(sample, AXES) == 0 && retry) {
+            std::this_thread::yield();
+        }
+        // without retries let the consumer in now and then, so some samples get through
+        if (!retry && ix % 8 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer_done.store(true);
+}
+
+/**
+ * @return number of samples received, or -1 on a sequence error
+ */
+static long consumer(bool lossless)
+{
+    float window[WINDOW_VALUES];
+    long next = 0;
+    long received = 0;
+
+    while (true) {
+        size_t available = ring.available();
+        if (available < WINDOW_VALUES) {
+            if (producer_done.load() && ring.available() < WINDOW_VALUES) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        // read in two parts like a DSP block asking for its axes, then release the window
+        ring.read(0, AXES, window);
+        ring.read(AXES, WINDOW_VALUES - AXES, window + AXES);
+        ring.consume(WINDOW_VALUES);
+
+        for (int ix = 0; ix < WINDOW_VALUES; ix += AXES) {
+            long sample = (long)window[ix] / AXES;
+            if ((long)window[ix] != sample * AXES || sample < next || (lossless && sample != next)) {
+                printf("FAIL: expected sample %ld, got value %.0f\n", next, window[ix]);
+                return -1;
+            }
+            for (int axis = 1; axis < AXES; axis++) {
+                if (window[ix + axis] != window[ix] + axis) {
+                    printf("FAIL: torn sample %ld (%.0f after %.0f)\n", sample, window[ix + axis], window[ix]);
+                    return -1;
+                }
+            }
+            next = sample + 1;
+            received++;
+        }
+    }
+
+    return received;
+}
+
+static bool run(bool lossless)
+{
+    long received = 0;
+
+    ring.reset();
+    producer_done.store(false);
+
+    std::thread consumer_thread([&]() { received = consumer(lossless); });
+    std::thread producer_thread(producer, lossless);
+    producer_thread.join();
+    consumer_thread.join();
+
+    if (received < 0) {
+        return false;
+    }
+
+    // at most one window minus a sample can be left in the ring, a full ring counts as a
+    // drop even when the producer retries
+    long left = (long)ring.available() / AXES;
+    long lost = lossless ? 0 : (long)ring.get_dropped();
+    long total = received + left + lost;
+    printf("%s: %ld received, %ld left, %u full\n", lossless ? "lossless" : "dropping",
+        received, left, ring.get_dropped());
+    if (total != SAMPLES) {
+        printf("FAIL: %ld samples accounted for, expected %d\n", total, SAMPLES);
+        return false;
+    }
+
+    return true;
+}
+
+int main(void)
+{
+    if (!run(true) || !run(false)) {
+        return 1;
+    }
+    printf("OK\n");
+
+    return 0;
+}
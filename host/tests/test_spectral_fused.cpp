@@ -0,0 +1,149 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Runs the fused de-interleave/moments path of extract_spec_features() and the reference
+ * path (transpose, scale, subtract_mean, rms and the skew/kurtosis loop) on random windows.
+ * The features quantized to the int8 input of the model must be bit for bit identical.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "tflite-model/tflite_learn_3_compiled.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define TEST_WINDOWS    5000
+
+using namespace ei;
+
+/**
+ * @brief      Uniform random number in [lo, hi)
+ */
+static float random_float(float lo, float hi)
+{
+    return lo + (hi - lo) * ((float)rand() / ((float)RAND_MAX + 1.0f));
+}
+
+/**
+ * @brief      Window of [samples][axes] with an offset, a sine and noise per axis
+ */
+static void random_window(std::vector<float> &window, size_t axes)
+{
+    const size_t samples = window.size() / axes;
+
+    for (size_t axis = 0; axis < axes; axis++) {
+        const float offset = random_float(-20.0f, 20.0f);
+        const float amplitude = random_float(0.01f, 10.0f);
+        const float noise = random_float(0.0f, 1.0f) * amplitude;
+        const float period = random_float(2.0f, (float)samples);
+
+        for (size_t ix = 0; ix < samples; ix++) {
+            window[ix * axes + axis] = offset + amplitude * sinf(2.0f * (float)M_PI * ix / period) +
+                random_float(-noise, noise);
+        }
+    }
+}
+
+/**
+ * @brief      Spectral features of a window, through the fused or the reference path
+ */
+static bool spectral_features(std::vector<float> window, size_t axes, bool fused, matrix_t *features)
+{
+    ei_dsp_config_spectral_analysis_t *config = &ei_dsp_config_2;
+    matrix_t input(window.size() / axes, axes, window.data());
+
+    if (fused) {
+        return spectral::feature::extract_spec_features(&input, features, config,
+            EI_CLASSIFIER_FREQUENCY) == features->cols;
+    }
+
+    // done by the caller, so extract_spec_features takes the unfused path
+    numpy::transpose_in_place(&input);
+    if (numpy::scale(&input, config->scale_axes) != EIDSP_OK) {
+        return false;
+    }
+    return spectral::feature::extract_spec_features(&input, features, config,
+        EI_CLASSIFIER_FREQUENCY, true, false) == features->cols;
+}
+
+int main(void)
+{
+    if (tflite_learn_3_init(&ei_aligned_calloc) != kTfLiteOk) {
+        printf("ERR: Failed to initialize the model\n");
+        return 1;
+    }
+    TfLiteTensor input;
+    tflite_learn_3_input(0, &input);
+    const float scale = input.params.scale;
+    const int zero_point = input.params.zero_point;
+    tflite_learn_3_reset(&ei_aligned_free);
+
+    const size_t axes = ei_dsp_config_2.axes;
+    std::vector<float> window(EI_CLASSIFIER_RAW_SAMPLE_COUNT * axes);
+    matrix_t expected(1, EI_CLASSIFIER_NN_INPUT_FRAME_SIZE);
+    matrix_t actual(1, EI_CLASSIFIER_NN_INPUT_FRAME_SIZE);
+    size_t mismatches = 0;
+    float max_diff = 0.0f;
+
+    srand(1);
+    for (size_t window_ix = 0; window_ix < TEST_WINDOWS; window_ix++) {
+        random_window(window, axes);
+
+        if (!spectral_features(window, axes, false, &expected) ||
+            !spectral_features(window, axes, true, &actual)) {
+            printf("ERR: Failed to extract the features of window %d\n", (int)window_ix);
+            return 1;
+        }
+
+        for (size_t ix = 0; ix < expected.cols; ix++) {
+            const int8_t q_expected = (int8_t)pre_cast_quantize(expected.buffer[ix], scale, zero_point, true);
+            const int8_t q_actual = (int8_t)pre_cast_quantize(actual.buffer[ix], scale, zero_point, true);
+            if (q_expected != q_actual) {
+                if (mismatches++ < 10) {
+                    printf("Window %d feature %d: reference %.9g (%d), fused %.9g (%d)\n",
+                        (int)window_ix, (int)ix, expected.buffer[ix], q_expected, actual.buffer[ix], q_actual);
+                }
+            }
+            max_diff = fmaxf(max_diff, fabsf(expected.buffer[ix] - actual.buffer[ix]));
+        }
+    }
+
+    printf("Windows: %d, mismatching int8 features: %d, max float difference %.3g\n",
+        TEST_WINDOWS, (int)mismatches, (double)max_diff);
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Streams random data slice by slice through extract_spectral_analysis_per_slice_features()
+ * and compares the features of every window with extract_spectral_analysis_features() on the
+ * same window. Slices of EI_CLASSIFIER_SLICE_SIZE (not a multiple of the FFT hop) and of
+ * multiples of the hop (full frames are reused) are tested, each with two blocks at once.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "tflite-model/tflite_learn_3_compiled.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define TEST_SLICES     2000
+
+using namespace ei;
+
+/**
+ * @brief      Uniform random number in [lo, hi)
+ */
+static float random_float(float lo, float hi)
+{
+    return lo + (hi - lo) * ((float)rand() / ((float)RAND_MAX + 1.0f));
+}
+
+/**
+ * @brief      Random stream of [samples][axes], an offset, a sine and noise per axis that
+ *             change every few hundred samples
+ */
+static void random_stream(std::vector<float> &stream, size_t axes)
+{
+    const size_t samples = stream.size() / axes;
+
+    for (size_t axis = 0; axis < axes; axis++) {
+        float offset = 0.0f, amplitude = 0.0f, noise = 0.0f, period = 1.0f;
+        for (size_t ix = 0; ix < samples; ix++) {
+            if (ix % 300 == 0) {
+                offset = random_float(-20.0f, 20.0f);
+                amplitude = random_float(0.01f, 10.0f);
+                noise = random_float(0.0f, 1.0f) * amplitude;
+                period = random_float(2.0f, 200.0f);
+            }
+            stream[ix * axes + axis] = offset + amplitude * sinf(2.0f * (float)M_PI * ix / period) +
+                random_float(-noise, noise);
+        }
+    }
+}
+
+/**
+ * @brief      Run the stream in slices of slice_size through two blocks, compare every window
+ */
+static bool test_slices(const std::vector<float> &stream, size_t axes, size_t slice_size,
+    float scale, int zero_point, size_t *mismatches, float *max_diff)
+{
+    ei_dsp_config_spectral_analysis_t configs[2] = { ei_dsp_config_2, ei_dsp_config_2 };
+    const size_t n_features = axes * (3 + ei_dsp_config_2.fft_length / 2);
+    const size_t window_size = EI_CLASSIFIER_RAW_SAMPLE_COUNT;
+    matrix_t expected(1, n_features);
+    matrix_t actual(1, n_features);
+    size_t windows = 0;
+
+    ei_dsp_clear_continuous_audio_state();
+
+    for (size_t pos = 0; pos + slice_size <= stream.size() / axes; pos += slice_size) {
+        for (size_t block = 0; block < 2; block++) {
+            signal_t slice;
+            if (numpy::signal_from_buffer(&stream[pos * axes], slice_size * axes, &slice) != EIDSP_OK) {
+                return false;
+            }
+            matrix_size_t written;
+            if (extract_spectral_analysis_per_slice_features(&slice, &actual, &configs[block],
+                    EI_CLASSIFIER_FREQUENCY, &written) != EIDSP_OK) {
+                printf("ERR: Per slice features failed at sample %d\n", (int)pos);
+                return false;
+            }
+
+            const size_t end = pos + slice_size;
+            if (end < window_size) {
+                if (written.rows * written.cols != 0) {
+                    printf("ERR: Features reported before the first full window\n");
+                    return false;
+                }
+                continue;
+            }
+            if (written.rows * written.cols != n_features) {
+                printf("ERR: No features reported at sample %d\n", (int)end);
+                return false;
+            }
+
+            // the reference gets a copy, it works in place
+            std::vector<float> window(&stream[(end - window_size) * axes], &stream[end * axes]);
+            signal_t window_signal;
+            if (numpy::signal_from_buffer(window.data(), window.size(), &window_signal) != EIDSP_OK ||
+                extract_spectral_analysis_features(&window_signal, &expected, &configs[block],
+                    EI_CLASSIFIER_FREQUENCY) != EIDSP_OK) {
+                printf("ERR: Failed to extract the features of the window at %d\n", (int)end);
+                return false;
+            }
+
+            for (size_t ix = 0; ix < n_features; ix++) {
+                const int8_t q_expected = (int8_t)pre_cast_quantize(expected.buffer[ix], scale, zero_point, true);
+                const int8_t q_actual = (int8_t)pre_cast_quantize(actual.buffer[ix], scale, zero_point, true);
+                if (q_expected != q_actual) {
+                    if ((*mismatches)++ < 10) {
+                        printf("Slice %d, window at %d, feature %d: window %.9g (%d), sliced %.9g (%d)\n",
+                            (int)slice_size, (int)end, (int)ix, expected.buffer[ix], q_expected,
+                            actual.buffer[ix], q_actual);
+                    }
+                }
+                *max_diff = fmaxf(*max_diff, fabsf(expected.buffer[ix] - actual.buffer[ix]));
+            }
+            windows++;
+        }
+    }
+
+    ei_dsp_clear_continuous_audio_state();
+
+    printf("Slice %d: %d windows\n", (int)slice_size, (int)windows);
+    return windows > 0;
+}
+
+int main(void)
+{
+    if (tflite_learn_3_init(&ei_aligned_calloc) != kTfLiteOk) {
+        printf("ERR: Failed to initialize the model\n");
+        return 1;
+    }
+    TfLiteTensor input;
+    tflite_learn_3_input(0, &input);
+    const float scale = input.params.scale;
+    const int zero_point = input.params.zero_point;
+    tflite_learn_3_reset(&ei_aligned_free);
+
+    const size_t axes = ei_dsp_config_2.axes;
+    const size_t hop = ei_dsp_config_2.do_fft_overlap ? ei_dsp_config_2.fft_length / 2 : ei_dsp_config_2.fft_length;
+    const size_t slice_sizes[] = { EI_CLASSIFIER_SLICE_SIZE, hop, 2 * hop, EI_CLASSIFIER_RAW_SAMPLE_COUNT };
+    std::vector<float> stream(TEST_SLICES * EI_CLASSIFIER_SLICE_SIZE * axes);
+    size_t mismatches = 0;
+    float max_diff = 0.0f;
+
+    srand(1);
+    random_stream(stream, axes);
+
+    for (size_t ix = 0; ix < sizeof(slice_sizes) / sizeof(slice_sizes[0]); ix++) {
+        if (!test_slices(stream, axes, slice_sizes[ix], scale, zero_point, &mismatches, &max_diff)) {
+            return 1;
+        }
+    }
+
+    printf("Mismatching int8 features: %d, max float difference %.3g\n", (int)mismatches, (double)max_diff);
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -35,6 +35,7 @@
 #include "ei_at_handlers.h"
 #include "ei_device_nordic_nrf7002dk.h"
 #include "ei_base64_encode.h"
+#include "ei_framed_transfer.h"
 #include "inference/ei_run_impulse.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "firmware-sdk/at-server/ei_at_command_set.h"
@@ -43,7 +44,9 @@
 #include "firmware-sdk/ei_fusion.h"
 #include "firmware-sdk/at_base64_lib.h"
 #include "firmware-sdk/ei_device_lib.h"
+#include "firmware-sdk/ei_classify_buffer_lib.h"
 #include "firmware-sdk/ei_device_interface.h"
+#include "firmware-sdk/ei_trace_lib.h"
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
 #include <string>
@@ -229,6 +232,8 @@ bool at_read_buffer(const char **argv, const int argc)
        use_max_baudrate = true;
     }
 
+    bool framed = (argc >= 4 && argv[3][0] == 'y');
+
     if (use_max_baudrate) {
         ei_printf("OK\r\n");
         ei_sleep(100);
@@ -236,7 +241,14 @@ bool at_read_buffer(const char **argv, const int argc)
         ei_sleep(100);
     }
 
-    bool success = read_encode_send(start, length);
+    bool success;
+    if (framed) {
+        ei_printf("OK FRAMED CHUNK=%d WINDOW=%d\r\n", EI_FRAME_MAX_PAYLOAD, EI_FRAME_WINDOW);
+        success = read_send_framed(start, length);
+    }
+    else {
+        success = read_encode_send(start, length);
+    }
 
     if (use_max_baudrate) {
         ei_printf("\r\nOK\r\n");
@@ -328,12 +340,74 @@ bool at_run_impulse_static_data(const char **argv, const int argc)
 
     bool debug = (argv[0][0] == 'y');
     size_t length = (size_t)atoi(argv[1]);
+    bool framed = (argc >= 3 && argv[2][0] == 'y');
 
-    bool res = run_impulse_static_data(debug, length, TRANSFER_BUF_LEN);
+    bool res;
+    if (framed) {
+        res = run_impulse_static_data_framed(debug, length, ei_uart_frame_io());
+    }
+    else {
+        res = run_impulse_static_data(debug, length, TRANSFER_BUF_LEN);
+    }
 
     return res;
 }
 
+bool at_bench_impulse(const char **argv, const int argc)
+{
+    EiDeviceNRF7002DK *dev = static_cast<EiDeviceNRF7002DK*>(EiDeviceInfo::get_device());
+    dev->set_serial_channel(UART);
+    if (check_args_num(1, argc) == false) {
+        return false;
+    }
+
+    int iterations = atoi(argv[0]);
+    if (iterations <= 0) {
+        ei_printf("ERR: Number of iterations has to be positive\n");
+        return false;
+    }
+
+    return run_impulse_benchmark((uint32_t)iterations);
+}
+
+bool at_classify_buffer(const char **argv, const int argc)
+{
+    EiDeviceNRF7002DK *dev = static_cast<EiDeviceNRF7002DK*>(EiDeviceInfo::get_device());
+    dev->set_serial_channel(UART);
+    if (check_args_num(3, argc) == false) {
+        return false;
+    }
+
+    uint32_t start = (uint32_t)atoi(argv[0]);
+    uint32_t length = (uint32_t)atoi(argv[1]);
+    int stride = atoi(argv[2]);
+    if (stride <= 0) {
+        ei_printf("ERR: Stride has to be positive\n");
+        return false;
+    }
+
+    bool quiet = (argc >= 4 && argv[3][0] == 'y');
+
+    return ei_classify_buffer(dev->get_memory(), start, length, (uint32_t)stride, !quiet);
+}
+
+#ifdef CONFIG_EI_TRACE
+bool at_trace_dump(void)
+{
+    EiDeviceNRF7002DK *dev = static_cast<EiDeviceNRF7002DK*>(EiDeviceInfo::get_device());
+    dev->set_serial_channel(UART);
+
+    return ei_trace_print_chrome_json();
+}
+
+bool at_trace_clear(void)
+{
+    ei_trace_reset();
+
+    return true;
+}
+#endif
+
 bool at_stop_impulse(void)
 {
     EiDeviceNRF7002DK *dev = static_cast<EiDeviceNRF7002DK*>(EiDeviceInfo::get_device());
@@ -501,6 +575,12 @@ ATServer *ei_at_init(void)
     at->register_command(AT_RUNIMPULSECONT, AT_RUNIMPULSECONT_HELP_TEXT, at_run_impulse_cont, nullptr, nullptr, nullptr);
     at->register_command("STOPIMPULSE", "", at_stop_impulse, nullptr, nullptr, nullptr);
     at->register_command(AT_RUNIMPULSESTATIC, AT_RUNIMPULSESTATIC_HELP_TEXT, nullptr, nullptr, at_run_impulse_static_data, AT_RUNIMPULSESTATIC_ARGS);
+    at->register_command(AT_BENCHIMPULSE, AT_BENCHIMPULSE_HELP_TEXT, nullptr, nullptr, at_bench_impulse, AT_BENCHIMPULSE_ARGS);
+    at->register_command(AT_CLASSIFYBUFFER, AT_CLASSIFYBUFFER_HELP_TEXT, nullptr, nullptr, at_classify_buffer, AT_CLASSIFYBUFFER_ARGS);
+#ifdef CONFIG_EI_TRACE
+    at->register_command(AT_TRACEDUMP, AT_TRACEDUMP_HELP_TEXT, at_trace_dump, nullptr, nullptr, nullptr);
+    at->register_command(AT_TRACECLEAR, AT_TRACECLEAR_HELP_TEXT, at_trace_clear, nullptr, nullptr, nullptr);
+#endif
 #ifdef CONFIG_WIFI_NRF700X
     at->register_command(AT_WIFI, AT_WIFI_HELP_TEXT, nullptr, &at_get_wifi, &at_set_wifi, AT_WIFI_ARGS);
     at->register_command(AT_SCANWIFI, AT_SCANWIFI_HELP_TEXT, &at_scan_wifi, nullptr, nullptr, nullptr);
@@ -38,6 +38,7 @@
 #include "firmware-sdk/ei_device_memory.h"
 #include "firmware-sdk/at_base64_lib.h"
 #include "ei_device_nordic_nrf7002dk.h"
+#include "ei_uart_async.h"
 #include <zephyr/logging/log.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/kernel.h>
@@ -50,38 +51,39 @@ bool read_encode_send(size_t address, size_t length)
     EiDeviceInfo *dev = EiDeviceInfo::get_device();
     EiDeviceMemory *memory = dev->get_memory();
     // we are encoiding data into base64, so it needs to be divisible by 3
-    const int buffer_size = 513;
-    uint8_t* buffer = (uint8_t*)ei_malloc(buffer_size);
+    const size_t buffer_size = 768;
+    uint8_t* buffer = (uint8_t*)ei_malloc(buffer_size + base64_encoded_size(buffer_size));
     if(buffer == nullptr) {
         LOG_ERR("Unable to allocate base64 encoder buffer");
         return false;
     }
+    char *encoded = (char *)&buffer[buffer_size];
+    bool success = true;
 
-    while (1) {
-        LOG_DBG("Reading %d bytes from %d", length, address);
+    LOG_DBG("Reading %d bytes from %d", length, address);
+
+    while (length > 0) {
         size_t bytes_to_read = buffer_size;
 
         if (bytes_to_read > length) {
             bytes_to_read = length;
         }
 
-        if (bytes_to_read == 0) {
-            ei_free(buffer);
-            return true;
-        }
-
+        // the previous block is still being sent while we read the next one
         if (memory->read_sample_data(buffer, address, bytes_to_read) != bytes_to_read) {
-            ei_free(buffer);
             LOG_ERR("Failed to read samples memory");
-            return false;
+            success = false;
+            break;
         }
 
-        base64_encode((char *)buffer, bytes_to_read, ei_putchar);
+        size_t encoded_size = base64_encode_block(buffer, bytes_to_read, encoded);
+        ei_uart_tx_write(encoded, encoded_size);
 
         address += bytes_to_read;
         length -= bytes_to_read;
     }
 
+    ei_uart_tx_flush();
     ei_free(buffer);
-    return true;
+    return success;
 }
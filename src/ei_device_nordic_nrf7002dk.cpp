@@ -41,9 +41,13 @@
 #include "ei_device_nordic_nrf7002dk.h"
 #include "flash_memory.h"
 #include "ei_at_handlers.h"
+#include "ei_uart_async.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "edge-impulse-sdk/dsp/ei_utils.h"
 #include "firmware-sdk/ei_device_memory.h"
+#ifdef CONFIG_EI_ACC_FIFO
+#include "sensors/ei_inertial_sensor.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ei_device_NRF7002DK);
@@ -255,6 +259,13 @@ bool EiDeviceNRF7002DK::start_sample_thread(void (*sample_read_cb)(void), float
     this->fusioning = 1;
 #endif
 
+#ifdef CONFIG_EI_ACC_FIFO
+    // sampling driven by the accelerometer FIFO, if the interval matches its ODR
+    if (ei_inertial_fifo_start(sample_read_cb, sample_interval_ms)) {
+        return true;
+    }
+#endif
+
     k_timer_start(&sampler_timer, K_MSEC(sample_interval_ms), K_MSEC(sample_interval_ms));
 
     return true;
@@ -263,6 +274,9 @@ bool EiDeviceNRF7002DK::start_sample_thread(void (*sample_read_cb)(void), float
 bool EiDeviceNRF7002DK::stop_sample_thread(void)
 {
     k_timer_stop(&sampler_timer);
+#ifdef CONFIG_EI_ACC_FIFO
+    ei_inertial_fifo_stop();
+#endif
 
 #if MULTI_FREQ_ENABLED == 1
     this->actual_timer = 0;
@@ -415,6 +429,9 @@ int uart_init(void)
         return -ENXIO;
     }
 
+    // failing to use the async API is not an error, TX and RX fall back to polling
+    ei_uart_async_init(uart);
+
     return err;
 }
 
@@ -427,9 +444,9 @@ int uart_init(void)
  */
 char uart_getchar(void)
 {
-    unsigned char rcv_char;
+    uint8_t rcv_char;
 
-    if (uart_poll_in(uart, &rcv_char) == 0) {
+    if (ei_uart_rx_read(&rcv_char, 1) == 1) {
         return rcv_char;
     }
     else{
@@ -437,6 +454,25 @@ char uart_getchar(void)
     }
 }
 
+/**
+ * @brief      Get char from UART (used by the firmware-sdk)
+ *
+ * @return     rcv_char If successful
+ * @return     0 If no data available
+ *
+ */
+char ei_getchar(void)
+{
+    uint8_t rcv_char;
+
+    if (ei_uart_rx_read(&rcv_char, 1) == 1) {
+        return rcv_char;
+    }
+    else {
+        return 0;
+    }
+}
+
 /**
  * @brief      Get char from UART
  *
@@ -452,6 +488,9 @@ void set_max_data_output_baudrate_c(void)
 {
     struct uart_config cfg;
 
+    // data queued at the current baudrate has to go out first
+    ei_uart_tx_flush();
+
     if(uart_config_get(uart, &cfg)) {
         LOG_ERR("ERR: can't get UART config!");
         ei_printf("ERR: can't get UART config!\n");
@@ -469,6 +508,9 @@ void set_default_data_output_baudrate_c(void)
 {
     struct uart_config cfg;
 
+    // data queued at the current baudrate has to go out first
+    ei_uart_tx_flush();
+
     if (uart_config_get(uart, &cfg)) {
         LOG_ERR("ERR: can't get UART config!");
         ei_printf("ERR: can't get UART config!\n");
@@ -0,0 +1,81 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_framed_transfer.h"
+#include "ei_uart_async.h"
+#include "firmware-sdk/ei_device_info_lib.h"
+#include "firmware-sdk/ei_device_memory.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(framed_transfer, CONFIG_EI_FRAMED_TRANSFER_LOG_LEVEL);
+
+/* Private functions ------------------------------------------------------- */
+static void uart_frame_write(const uint8_t *data, size_t length)
+{
+    ei_uart_tx_write((const char *)data, length);
+}
+
+static bool memory_source(void *ctx, size_t offset, uint8_t *data, size_t length)
+{
+    EiDeviceMemory *memory = EiDeviceInfo::get_device()->get_memory();
+    size_t address = *(size_t *)ctx + offset;
+
+    if (memory->read_sample_data(data, address, length) != length) {
+        LOG_ERR("Failed to read samples memory");
+        return false;
+    }
+
+    return true;
+}
+
+/* Private variables ------------------------------------------------------- */
+static const ei_frame_io_t uart_frame_io = {
+    uart_frame_write,
+    ei_uart_rx_read,
+    ei_uart_tx_flush
+};
+
+/* Public functions -------------------------------------------------------- */
+const ei_frame_io_t *ei_uart_frame_io(void)
+{
+    return &uart_frame_io;
+}
+
+bool read_send_framed(size_t address, size_t length)
+{
+    LOG_DBG("Sending %d bytes from %d as frames", length, address);
+
+    return ei_frame_send(&uart_frame_io, length, memory_source, &address);
+}
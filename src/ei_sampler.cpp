@@ -39,10 +39,12 @@
 #include "firmware-sdk/ei_config_types.h"
 #include "firmware-sdk/sensor-aq/sensor_aq_none.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include "wifi/ei_ws_client.h"
 
 #define LOG_MODULE_NAME ei_sampler
@@ -53,16 +55,30 @@ static size_t ei_write(const void *buffer, size_t size, size_t count, EI_SENSOR_
 static int ei_seek(EI_SENSOR_AQ_STREAM *, long int offset, int origin);
 static bool sample_data_callback(const void *sample_buf, uint32_t byteLenght);
 static bool create_header(sensor_aq_payload_info *payload);
+static void write_buffered_frames(void);
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+static bool erase_ahead_start(EiDeviceMemory *mem, uint32_t size);
+static void erase_ahead_stop(void);
+static bool erase_ahead_wait(uint32_t address);
+#endif
 
 /* Private variables ------------------------------------------------------- */
 static uint32_t samples_required;
 static uint32_t current_sample;
 static uint32_t sample_buffer_size;
 static uint32_t headerOffset = 0;
-static uint8_t write_word_buf[4] __attribute__((aligned(4)));
 static int write_addr = 0;
 EI_SENSOR_AQ_STREAM stream;
 
+static float frame_buffer[CONFIG_EI_SAMPLER_FRAMES_PER_WRITE * EI_MAX_SENSOR_AXES];
+static size_t frame_values;
+static size_t frames_buffered;
+#ifdef CONFIG_EI_SAMPLER_CBOR_HALF_FLOAT
+static const sensor_aq_float_encoding sample_encoding = AQ_FLOAT_ENCODING_HALF;
+#else
+static const sensor_aq_float_encoding sample_encoding = AQ_FLOAT_ENCODING_SMALLEST;
+#endif
+
 static unsigned char ei_mic_ctx_buffer[1024] __attribute__((aligned(4)));
 static sensor_aq_signing_ctx_t ei_mic_signing_ctx;
 static sensor_aq_ctx ei_sampler_ctx = {
@@ -73,9 +89,26 @@ static sensor_aq_ctx ei_sampler_ctx = {
     nullptr,
 };
 
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+static void erase_work_handler(struct k_work *work);
+
+K_THREAD_STACK_DEFINE(erase_stack, CONFIG_EI_SAMPLER_ERASE_THREAD_STACK);
+K_WORK_DEFINE(erase_work, erase_work_handler);
+K_SEM_DEFINE(erase_progress_sem, 0, 1);
+
+static struct k_work_q erase_work_q;
+static bool erase_work_q_started = false;
+/* all addresses are relative to the beginning of the sample memory */
+static atomic_t erased_bytes;
+static atomic_t erase_end;
+static atomic_t erase_write_pos;
+static atomic_t erase_failed;
+#endif
+
 /**
  * @brief      Write sample data to FLASH
- * @details    Write size is always 4 bytes to keep alignment
+ * @details    Data is passed in one go to the memory driver, which combines
+ *             the writes into whole flash pages
  *
  * @param[in]  buffer     The buffer
  * @param[in]  size       The size
@@ -88,14 +121,18 @@ static size_t ei_write(const void *buffer, size_t size, size_t count, EI_SENSOR_
 {
     EiDeviceMemory* mem = EiDeviceInfo::get_device()->get_memory();
 
-    for (size_t i = 0; i < count; i++) {
-        write_word_buf[write_addr & 0x3] = *((char *)buffer + i);
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+    if (!erase_ahead_wait(write_addr + headerOffset + count)) {
+        return 0;
+    }
+#endif
 
-        if ((++write_addr & 0x03) == 0x00) {
-            mem->write_sample_data(write_word_buf, (write_addr - 4) + headerOffset, 4);
-        }
+    if (mem->write_sample_data((const uint8_t *)buffer, write_addr + headerOffset, count) != count) {
+        return 0;
     }
 
+    write_addr += count;
+
     return count;
 }
 
@@ -108,29 +145,16 @@ static int ei_seek(EI_SENSOR_AQ_STREAM *, long int offset, int origin)
 }
 
 /**
- * @brief      Write out remaining data in word buffer to FLASH.
- *             And append CBOR end character.
+ * @brief      Append CBOR end character and write out all data
+ *             still buffered by the memory driver to FLASH.
  */
 static void ei_write_last_data(void)
 {
     EiDeviceMemory* mem = EiDeviceInfo::get_device()->get_memory();
-    uint8_t fill = ((uint8_t)write_addr & 0x03);
-    uint8_t insert_end_address = 0;
-
-    if (fill != 0x00) {
-        for (uint8_t i = fill; i < 4; i++) {
-            write_word_buf[i] = 0xFF;
-        }
+    const uint8_t end_char = 0xFF;
 
-        mem->write_sample_data(write_word_buf, (write_addr & ~0x03) + headerOffset, 4);
-        insert_end_address = 4;
-    }
-
-    /* Write appending word for end character */
-    for (uint8_t i = 0; i < 4; i++) {
-        write_word_buf[i] = 0xFF;
-    }
-    mem->write_sample_data(write_word_buf, (write_addr & ~0x03) + headerOffset + insert_end_address, 4);
+    ei_write(&end_char, 1, 1, nullptr);
+    mem->flush_data();
 }
 
 bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_start, uint32_t sample_size)
@@ -179,8 +203,15 @@ bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_s
     sample_buffer_size = (samples_required * sample_size) * 2;
     current_sample = 0;
 
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+    // only the first block is erased upfront, the rest is erased while sampling
+    uint32_t erase_size = mem->block_size;
+#else
+    uint32_t erase_size = sample_buffer_size;
+#endif
+
     // Minimum delay of 2000 ms for daemon
-    uint32_t delay_time_ms = ((sample_buffer_size / mem->block_size) + 1) * mem->block_erase_time;
+    uint32_t delay_time_ms = ((erase_size / mem->block_size) + 1) * mem->block_erase_time;
     if(dev->get_serial_channel() == UART) {
         LOG_DBG("UART COM: Starting in %d ms...(or until all flash was erased)", delay_time_ms < 2000 ? 2000 : delay_time_ms);
         ei_printf("Starting in %u ms... (or until all flash was erased)\n", delay_time_ms < 2000 ? 2000 : delay_time_ms);
@@ -194,7 +225,11 @@ bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_s
 
     dev->set_state(eiStateErasingFlash);
 
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+    if(erase_ahead_start(mem, sample_buffer_size) == false) {
+#else
     if(mem->erase_sample_data(0, sample_buffer_size) != (sample_buffer_size)) {
+#endif
         if(dev->get_serial_channel() == UART){
             LOG_ERR("UART COM: Failed to erase samples memory");
             ei_printf("ERR: Failed to erase samples memory\n");
@@ -210,11 +245,17 @@ bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_s
 
     if (create_header(payload) == false) {
         LOG_ERR("Failed to create header");
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+        erase_ahead_stop();
+#endif
         return false;
     }
 
     if (ei_sample_start(&sample_data_callback, dev->get_sample_interval_ms()) == false) {
         LOG_ERR("Failed to start sampling");
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+        erase_ahead_stop();
+#endif
         return false;
     }
 
@@ -241,7 +282,10 @@ bool ei_sampler_start_sampling(void *v_ptr_payload, starter_callback ei_sample_s
     dev->stop_sample_thread();
 
     ei_write_last_data();
-    write_addr++;
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+    // the header block is rewritten below, make sure the eraser is not busy anymore
+    erase_ahead_stop();
+#endif
 
     uint8_t final_byte[] = {0xff};
     int ctx_err = ei_sampler_ctx.signature_ctx->update(ei_sampler_ctx.signature_ctx, final_byte, 1);
@@ -410,12 +454,31 @@ static bool create_header(sensor_aq_payload_info *payload)
 
     headerOffset = end_of_header_ix;
     write_addr = 0;
+    frames_buffered = 0;
 
     return true;
 }
 
 /**
- * @brief      Write samples to FLASH in CBOR format
+ * @brief      Encode all buffered frames in CBOR format and write them to FLASH
+ */
+static void write_buffered_frames(void)
+{
+    if (frames_buffered == 0) {
+        return;
+    }
+
+    int ret = sensor_aq_add_data_frames(&ei_sampler_ctx, frame_buffer, frame_values, frames_buffered, sample_encoding);
+    if (ret != AQ_OK) {
+        LOG_ERR("Failed to write %u frames (%d)", frames_buffered, ret);
+    }
+
+    frames_buffered = 0;
+}
+
+/**
+ * @brief      Collect samples and write them to FLASH in CBOR format,
+ *             CONFIG_EI_SAMPLER_FRAMES_PER_WRITE frames at a time
  *
  * @param[in]  sample_buf  The sample buffer
  * @param[in]  byteLenght  The byte lenght
@@ -424,7 +487,19 @@ static bool create_header(sensor_aq_payload_info *payload)
  */
 static bool sample_data_callback(const void *sample_buf, uint32_t byteLenght)
 {
-    sensor_aq_add_data(&ei_sampler_ctx, (float *)sample_buf, byteLenght / sizeof(float));
+    EI_TRACE_ZONE("sampler_callback");
+    size_t values = byteLenght / sizeof(float);
+
+    if (values > 0 && values <= EI_MAX_SENSOR_AXES) {
+        frame_values = values;
+        memcpy(&frame_buffer[frames_buffered * frame_values], sample_buf, values * sizeof(float));
+        frames_buffered++;
+    }
+
+    // write out the last frames as soon as they are here
+    if (frames_buffered == CONFIG_EI_SAMPLER_FRAMES_PER_WRITE || current_sample + 1 >= samples_required) {
+        write_buffered_frames();
+    }
 
     if (++current_sample > samples_required) {
         return true;
@@ -438,3 +513,106 @@ uint32_t ei_sampler_get_data_size(void)
 {
     return write_addr + headerOffset;
 }
+
+#ifdef CONFIG_EI_SAMPLER_ERASE_AHEAD
+/**
+ * @brief      Erase blocks until we are CONFIG_EI_SAMPLER_ERASE_AHEAD_BLOCKS
+ *             ahead of the write position or the whole sample area is erased.
+ *             Resubmitted by the writer every time it enters a new block.
+ */
+static void erase_work_handler(struct k_work *work)
+{
+    EiDeviceMemory *mem = EiDeviceInfo::get_device()->get_memory();
+    const uint32_t ahead_bytes = CONFIG_EI_SAMPLER_ERASE_AHEAD_BLOCKS * mem->block_size;
+    uint32_t erased = (uint32_t)atomic_get(&erased_bytes);
+
+    while (erased < (uint32_t)atomic_get(&erase_end)
+           && erased < (uint32_t)atomic_get(&erase_write_pos) + ahead_bytes) {
+        if (mem->erase_sample_data(erased, mem->block_size) != mem->block_size) {
+            LOG_ERR("Failed to erase block at 0x%x", erased);
+            atomic_set(&erase_failed, 1);
+            k_sem_give(&erase_progress_sem);
+            return;
+        }
+
+        erased += mem->block_size;
+        atomic_set(&erased_bytes, erased);
+        k_sem_give(&erase_progress_sem);
+    }
+}
+
+/**
+ * @brief      Erase the first block (holding the header) and start erasing
+ *             the rest of the sample area in the background
+ *
+ * @param      mem   Sample memory
+ * @param[in]  size  Number of bytes that will be written
+ *
+ * @return     false if the first block couldn't be erased
+ */
+static bool erase_ahead_start(EiDeviceMemory *mem, uint32_t size)
+{
+    if (!erase_work_q_started) {
+        k_work_queue_start(&erase_work_q, erase_stack, K_THREAD_STACK_SIZEOF(erase_stack),
+                           CONFIG_EI_SAMPLER_ERASE_THREAD_PRIO, NULL);
+        k_thread_name_set(&erase_work_q.thread, "ei_erase_ahead");
+        erase_work_q_started = true;
+    }
+
+    // in case previous sampling was interrupted
+    erase_ahead_stop();
+
+    if (mem->erase_sample_data(0, mem->block_size) != mem->block_size) {
+        return false;
+    }
+
+    atomic_set(&erase_failed, 0);
+    atomic_set(&erase_write_pos, 0);
+    atomic_set(&erased_bytes, mem->block_size);
+    atomic_set(&erase_end, size);
+    k_sem_reset(&erase_progress_sem);
+
+    k_work_submit_to_queue(&erase_work_q, &erase_work);
+
+    return true;
+}
+
+/**
+ * @brief      Stop erasing, waits until the block being erased is done
+ */
+static void erase_ahead_stop(void)
+{
+    struct k_work_sync sync;
+
+    atomic_set(&erase_end, 0);
+    k_work_cancel_sync(&erase_work, &sync);
+}
+
+/**
+ * @brief      Block the writer until the sample memory up to address is erased
+ *
+ * @param[in]  address  End address (exclusive) of the data to be written
+ *
+ * @return     false if erasing failed
+ */
+static bool erase_ahead_wait(uint32_t address)
+{
+    EiDeviceMemory *mem = EiDeviceInfo::get_device()->get_memory();
+    uint32_t write_pos = (uint32_t)atomic_get(&erase_write_pos);
+
+    if (address / mem->block_size != write_pos / mem->block_size) {
+        atomic_set(&erase_write_pos, address);
+        k_work_submit_to_queue(&erase_work_q, &erase_work);
+    }
+
+    while ((uint32_t)atomic_get(&erased_bytes) < address) {
+        if (atomic_get(&erase_failed)) {
+            return false;
+        }
+        LOG_DBG("Waiting for erase ahead (0x%x < 0x%x)", (uint32_t)atomic_get(&erased_bytes), address);
+        k_sem_take(&erase_progress_sem, K_MSEC(mem->block_erase_time));
+    }
+
+    return true;
+}
+#endif
@@ -0,0 +1,218 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Include ----------------------------------------------------------------- */
+#include "ei_uart_async.h"
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(uart_async, CONFIG_EI_UART_ASYNC_LOG_LEVEL);
+
+/* Constants --------------------------------------------------------------- */
+#define RX_CHUNK_SIZE       64
+#define RX_TIMEOUT_US       200
+
+/* Private variables ------------------------------------------------------- */
+RING_BUF_DECLARE(tx_ring, CONFIG_EI_UART_TX_BUFFER_SIZE);
+static K_SEM_DEFINE(tx_space_sem, 0, 1);
+static K_SEM_DEFINE(tx_idle_sem, 0, 1);
+static struct k_spinlock tx_lock;
+static bool tx_busy = false;
+
+RING_BUF_DECLARE(rx_ring, CONFIG_EI_UART_RX_BUFFER_SIZE);
+static uint8_t rx_chunks[2][RX_CHUNK_SIZE];
+static uint8_t rx_next_chunk = 0;
+/* bytes the RX callback couldn't fit into rx_ring, reported and cleared by ei_uart_rx_read */
+static atomic_t rx_dropped = ATOMIC_INIT(0);
+
+static const struct device *uart_dev;
+static bool uart_async = false;
+
+/* Private functions ------------------------------------------------------- */
+
+/**
+ * @brief      Start a DMA transfer of the next contiguous part of the ring buffer.
+ *             Must be called with tx_lock held.
+*/
+static void tx_start_locked(void)
+{
+    uint8_t *data;
+    uint32_t len = ring_buf_get_claim(&tx_ring, &data, CONFIG_EI_UART_TX_BUFFER_SIZE);
+
+    if (len == 0) {
+        tx_busy = false;
+        k_sem_give(&tx_idle_sem);
+        return;
+    }
+
+    if (uart_tx(uart_dev, data, len, SYS_FOREVER_US) != 0) {
+        // shouldn't happen, but don't lose the data
+        for (uint32_t ix = 0; ix < len; ix++) {
+            uart_poll_out(uart_dev, data[ix]);
+        }
+        ring_buf_get_finish(&tx_ring, len);
+        tx_busy = false;
+        k_sem_give(&tx_space_sem);
+        k_sem_give(&tx_idle_sem);
+        return;
+    }
+
+    tx_busy = true;
+}
+
+/**
+ * @brief      (Re)start reception into the two DMA chunks, received data is moved
+ *             to rx_ring as soon as the line goes idle or a chunk is full
+*/
+static int rx_start(void)
+{
+    rx_next_chunk = 1;
+    return uart_rx_enable(uart_dev, rx_chunks[0], RX_CHUNK_SIZE, RX_TIMEOUT_US);
+}
+
+static void uart_callback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+    k_spinlock_key_t key;
+    uint32_t written;
+
+    switch (evt->type) {
+        case UART_TX_DONE:
+        case UART_TX_ABORTED:
+            key = k_spin_lock(&tx_lock);
+            ring_buf_get_finish(&tx_ring, evt->data.tx.len);
+            k_sem_give(&tx_space_sem);
+            tx_start_locked();
+            k_spin_unlock(&tx_lock, key);
+            break;
+        case UART_RX_RDY:
+            written = ring_buf_put(&rx_ring, evt->data.rx.buf + evt->data.rx.offset, evt->data.rx.len);
+            atomic_add(&rx_dropped, evt->data.rx.len - written);
+            break;
+        case UART_RX_BUF_REQUEST:
+            uart_rx_buf_rsp(dev, rx_chunks[rx_next_chunk], RX_CHUNK_SIZE);
+            rx_next_chunk ^= 1;
+            break;
+        case UART_RX_DISABLED:
+            // after a line error or when running out of chunks
+            rx_start();
+            break;
+        default:
+            break;
+    }
+}
+
+/* Public functions -------------------------------------------------------- */
+
+int ei_uart_async_init(const struct device *dev)
+{
+    int err;
+
+    uart_dev = dev;
+    err = uart_callback_set(dev, uart_callback, NULL);
+    if (err == 0) {
+        err = rx_start();
+    }
+    uart_async = (err == 0);
+
+    if (!uart_async) {
+        LOG_WRN("UART async API not available (%d), using polling", err);
+    }
+
+    return err;
+}
+
+void ei_uart_tx_write(const char *data, size_t len)
+{
+    if (!uart_async) {
+        while (len--) {
+            uart_poll_out(uart_dev, *data++);
+        }
+        return;
+    }
+
+    while (len > 0) {
+        uint32_t written = ring_buf_put(&tx_ring, (const uint8_t *)data, len);
+        data += written;
+        len -= written;
+
+        k_spinlock_key_t key = k_spin_lock(&tx_lock);
+        if (!tx_busy) {
+            tx_start_locked();
+        }
+        k_spin_unlock(&tx_lock, key);
+
+        if (len > 0) {
+            // wait for the current transfer to free some space
+            k_sem_take(&tx_space_sem, K_MSEC(100));
+        }
+    }
+}
+
+void ei_uart_tx_flush(void)
+{
+    if (!uart_async) {
+        return;
+    }
+
+    while (true) {
+        k_spinlock_key_t key = k_spin_lock(&tx_lock);
+        bool pending = tx_busy || !ring_buf_is_empty(&tx_ring);
+        k_spin_unlock(&tx_lock, key);
+
+        if (!pending) {
+            break;
+        }
+        k_sem_take(&tx_idle_sem, K_MSEC(100));
+    }
+}
+
+size_t ei_uart_rx_read(uint8_t *data, size_t len)
+{
+    if (!uart_async) {
+        size_t count = 0;
+        while (count < len && uart_poll_in(uart_dev, &data[count]) == 0) {
+            count++;
+        }
+        return count;
+    }
+
+    atomic_val_t dropped = atomic_clear(&rx_dropped);
+    if (dropped != 0) {
+        LOG_WRN("UART RX buffer overflow, %u bytes dropped", (unsigned int)dropped);
+    }
+
+    return ring_buf_get(&rx_ring, data, len);
+}
@@ -0,0 +1,73 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_UART_ASYNC_H
+#define EI_UART_ASYNC_H
+
+#include <zephyr/device.h>
+#include <cstddef>
+#include <cstdint>
+
+/* Function prototypes ----------------------------------------------------- */
+
+/**
+ * @brief      Set up buffered transmission and reception on the UART, using the async
+ *             (DMA) API when the driver supports it and polling otherwise
+ * @param[in]  dev  UART device
+ * @return     0 if async API is used, negative error code if falling back to polling
+*/
+int ei_uart_async_init(const struct device *dev);
+
+/**
+ * @brief      Queue data for transmission, blocks only while the TX buffer is full
+ * @param[in]  data  Data to send
+ * @param[in]  len   Length of data
+*/
+void ei_uart_tx_write(const char *data, size_t len);
+
+/**
+ * @brief      Wait until all queued data has been sent. Call before writing to the UART
+ *             in any other way (ei_printf, ei_putchar) or changing its configuration.
+*/
+void ei_uart_tx_flush(void);
+
+/**
+ * @brief      Read received data without blocking
+ * @param[out] data  Buffer for the received data
+ * @param[in]  len   Size of the buffer
+ * @return     Number of bytes read, 0 if nothing was received
+*/
+size_t ei_uart_rx_read(uint8_t *data, size_t len);
+
+#endif /* EI_UART_ASYNC_H */
@@ -34,6 +34,7 @@
 
 #include "flash_memory.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include <zephyr/drivers/flash.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/storage/flash_map.h>
@@ -41,8 +42,21 @@
 
 LOG_MODULE_REGISTER(ei_flash, LOG_LEVEL_DBG);
 
+BUILD_ASSERT((EI_FLASH_WRITE_BUFFER_SIZE & (EI_FLASH_WRITE_BUFFER_SIZE - 1)) == 0,
+             "EI_FLASH_WRITE_BUFFER_SIZE has to be a power of two");
+/* the sampler erases blocks ahead of the writer from another thread, a buffered page
+ * must never reach into a block that is still being erased */
+BUILD_ASSERT(EI_FLASH_WRITE_BUFFER_SIZE <= EI_FLASH_BLOCK_SIZE,
+             "EI_FLASH_WRITE_BUFFER_SIZE can't be larger than a flash block");
+
+/* guards the write buffer state, erase_sample_data runs on the sampler's erase-ahead
+ * work queue while the sampler thread writes. k_mutex is recursive, so flush_data
+ * can be called with it held. */
+static K_MUTEX_DEFINE(write_buffer_mutex);
+
 uint32_t EiFlashMemory::read_data(uint8_t *data, uint32_t address, uint32_t num_bytes)
 {
+    EI_TRACE_ZONE("flash_read");
     int ret;
 
     ret = flash_area_read(ext_flash_area, address, (void*)data, num_bytes);
@@ -56,6 +70,7 @@ uint32_t EiFlashMemory::read_data(uint8_t *data, uint32_t address, uint32_t num_
 
 uint32_t EiFlashMemory::write_data(const uint8_t *data, uint32_t address, uint32_t num_bytes)
 {
+    EI_TRACE_ZONE("flash_write");
     uint16_t write_block = flash_area_align(ext_flash_area);
     uint32_t bytes_to_write = num_bytes;
     int ret;
@@ -81,6 +96,7 @@ uint32_t EiFlashMemory::write_data(const uint8_t *data, uint32_t address, uint32
 
 uint32_t EiFlashMemory::erase_data(uint32_t address, uint32_t num_bytes)
 {
+    EI_TRACE_ZONE("flash_erase");
     int ret;
     uint32_t num_bytes_to_erase = num_bytes;
     // calculate address offset from block alignment
@@ -115,8 +131,132 @@ uint32_t EiFlashMemory::erase_data(uint32_t address, uint32_t num_bytes)
     return 0;
 }
 
-EiFlashMemory::EiFlashMemory(uint32_t config_size):EiDeviceMemory(config_size, 90, 0, 4096)
+/**
+ * @brief      Read sample data. Anything still waiting in the write buffer is
+ *             programmed first, so the caller always sees the latest data.
+ */
+uint32_t EiFlashMemory::read_sample_data(uint8_t *sample_data, uint32_t address, uint32_t sample_data_size)
+{
+    flush_data();
+
+    return EiDeviceMemory::read_sample_data(sample_data, address, sample_data_size);
+}
+
+/**
+ * @brief      Write sample data through the page buffer. Data is collected in RAM
+ *             and programmed when a page is complete, when a write lands in another
+ *             page or when flush_data() is called. Whole aligned pages coming from
+ *             the caller are programmed directly without copying.
+ *
+ * @return     number of bytes accepted
+ */
+uint32_t EiFlashMemory::write_sample_data(const uint8_t *sample_data, uint32_t address, uint32_t sample_data_size)
+{
+    uint32_t written = 0;
+
+    address += used_blocks * block_size;
+
+    k_mutex_lock(&write_buffer_mutex, K_FOREVER);
+    while (written < sample_data_size) {
+        uint32_t page_address = address & ~(EI_FLASH_WRITE_BUFFER_SIZE - 1);
+        uint32_t page_offset = address - page_address;
+        uint32_t chunk = MIN(sample_data_size - written, EI_FLASH_WRITE_BUFFER_SIZE - page_offset);
+
+        if (write_buffer_dirty && write_buffer_address != page_address) {
+            flush_data();
+        }
+
+        if (!write_buffer_dirty && chunk == EI_FLASH_WRITE_BUFFER_SIZE) {
+            if (write_data(sample_data + written, address, chunk) != chunk) {
+                break;
+            }
+        }
+        else {
+            if (!write_buffer_dirty) {
+                // erased flash reads as 0xFF, programming 0xFF leaves the byte untouched
+                memset(write_buffer, 0xFF, sizeof(write_buffer));
+                write_buffer_address = page_address;
+                write_buffer_start = page_offset;
+                write_buffer_end = page_offset;
+                write_buffer_dirty = true;
+            }
+
+            memcpy(&write_buffer[page_offset], sample_data + written, chunk);
+            write_buffer_start = MIN(write_buffer_start, page_offset);
+            write_buffer_end = MAX(write_buffer_end, page_offset + chunk);
+
+            if (write_buffer_start == 0 && write_buffer_end == EI_FLASH_WRITE_BUFFER_SIZE) {
+                if (flush_data() != EI_FLASH_WRITE_BUFFER_SIZE) {
+                    break;
+                }
+            }
+        }
+
+        address += chunk;
+        written += chunk;
+    }
+    k_mutex_unlock(&write_buffer_mutex);
+
+    return written;
+}
+
+/**
+ * @brief      Erase sample data. Buffered data that falls completely inside the
+ *             erased region is dropped, otherwise it is programmed before erasing.
+ *             The write buffer is not touched when it doesn't overlap the erased
+ *             region, which lets the sampler erase ahead from another thread. Only
+ *             the buffer check holds the lock, the writer isn't blocked by the erase.
+ */
+uint32_t EiFlashMemory::erase_sample_data(uint32_t address, uint32_t num_bytes)
 {
+    uint32_t erase_start = used_blocks * block_size + address;
+
+    k_mutex_lock(&write_buffer_mutex, K_FOREVER);
+    if (write_buffer_dirty
+        && write_buffer_address < erase_start + num_bytes
+        && write_buffer_address + EI_FLASH_WRITE_BUFFER_SIZE > erase_start) {
+        if (write_buffer_address >= erase_start
+            && write_buffer_address + EI_FLASH_WRITE_BUFFER_SIZE <= erase_start + num_bytes) {
+            write_buffer_dirty = false;
+        }
+        else {
+            flush_data();
+        }
+    }
+    k_mutex_unlock(&write_buffer_mutex);
+
+    return EiDeviceMemory::erase_sample_data(address, num_bytes);
+}
+
+/**
+ * @brief      Program the dirty part of the write buffer (word aligned) into flash
+ *
+ * @return     number of bytes programmed, 0 if there was nothing to flush or an error occurred
+ */
+uint32_t EiFlashMemory::flush_data(void)
+{
+    uint32_t ret = 0;
+
+    k_mutex_lock(&write_buffer_mutex, K_FOREVER);
+    if (write_buffer_dirty) {
+        uint32_t start = write_buffer_start & ~0x03;
+        uint32_t end = (write_buffer_end + 0x03) & ~0x03;
+
+        write_buffer_dirty = false;
+        ret = write_data(&write_buffer[start], write_buffer_address + start, end - start);
+    }
+    k_mutex_unlock(&write_buffer_mutex);
+
+    return ret;
+}
+
+EiFlashMemory::EiFlashMemory(uint32_t config_size):EiDeviceMemory(config_size, 90, 0, EI_FLASH_BLOCK_SIZE)
+{
+    write_buffer_address = 0;
+    write_buffer_start = 0;
+    write_buffer_end = 0;
+    write_buffer_dirty = false;
+
     int err;
     err = flash_area_open(FLASH_AREA_ID(external_flash), (const flash_area**)&ext_flash_area);
     if(err) {
@@ -131,5 +271,5 @@ EiFlashMemory::EiFlashMemory(uint32_t config_size):EiDeviceMemory(config_size, 9
     LOG_DBG("Flash device size: %lu bytes", ext_flash_area->fa_size);
     LOG_DBG("Flash device offset: 0x%x", ext_flash_area->fa_off);
     LOG_DBG("Flash device align: 0x%x", flash_area_align(ext_flash_area));
-    LOG_DBG("Flash device sector size: %d bytes", 4096);
+    LOG_DBG("Flash device sector size: %d bytes", EI_FLASH_BLOCK_SIZE);
 }
@@ -38,9 +38,20 @@
 #include "firmware-sdk/ei_device_memory.h"
 #include <zephyr/storage/flash_map.h>
 
+#define EI_FLASH_WRITE_BUFFER_SIZE  CONFIG_EI_FLASH_WRITE_BUFFER_SIZE
+#define EI_FLASH_BLOCK_SIZE         4096
+
 class EiFlashMemory : public EiDeviceMemory {
 private:
     struct flash_area *ext_flash_area;
+    /* sample writes are combined here and programmed as whole pages, the buffer state is
+     * guarded by write_buffer_mutex (flash_memory.cpp) */
+    uint8_t write_buffer[EI_FLASH_WRITE_BUFFER_SIZE] __attribute__((aligned(4)));
+    uint32_t write_buffer_address;
+    uint32_t write_buffer_start;
+    uint32_t write_buffer_end;
+    bool write_buffer_dirty;
+
 protected:
     uint32_t read_data(uint8_t *data, uint32_t address, uint32_t num_bytes);
     uint32_t write_data(const uint8_t *data, uint32_t address, uint32_t num_bytes);
@@ -48,6 +59,11 @@ protected:
 
 public:
     EiFlashMemory(uint32_t config_size);
+
+    uint32_t read_sample_data(uint8_t *sample_data, uint32_t address, uint32_t sample_data_size) override;
+    uint32_t write_sample_data(const uint8_t *sample_data, uint32_t address, uint32_t sample_data_size) override;
+    uint32_t erase_sample_data(uint32_t address, uint32_t num_bytes) override;
+    uint32_t flush_data(void) override;
 };
 
 #endif /* EI_FLASH_MEMORY_H */
\ No newline at end of file
@@ -35,9 +35,15 @@
 #include "model-parameters/model_metadata.h"
 #if defined(EI_CLASSIFIER_SENSOR) && ((EI_CLASSIFIER_SENSOR == EI_CLASSIFIER_SENSOR_FUSION) || (EI_CLASSIFIER_SENSOR == EI_CLASSIFIER_SENSOR_ACCELEROMETER))
 #include "edge-impulse-sdk/classifier/ei_run_classifier.h"
-#include "edge-impulse-sdk/dsp/numpy.hpp"
 #include "firmware-sdk/ei_fusion.h"
+#ifdef CONFIG_EI_RESULT_EVENTS
+#include "edge-impulse-sdk/classifier/ei_classifier_smooth.h"
+#include "firmware-sdk/remote-mgmt.h"
+#include "wifi/ei_ws_client.h"
+#endif
 #include "ei_device_nordic_nrf7002dk.h"
+#include "ei_samples_ring.h"
+#include "ei_run_impulse.h"
 #include <zephyr/kernel.h>
 #include "cJSON.h"
 #include <zephyr/logging/log.h>
@@ -46,20 +52,35 @@ LOG_MODULE_REGISTER(run_impulse);
 typedef enum {
     INFERENCE_STOPPED,
     INFERENCE_WAITING,
-    INFERENCE_SAMPLING,
-    INFERENCE_DATA_READY
+    INFERENCE_SAMPLING
 } inference_state_t;
 
+#define SAMPLES_RING_SIZE   EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE
+#define EVENT_SEND_TIMEOUT_MS   100
+
 static int print_results;
 static uint16_t samples_per_inference;
 static inference_state_t state = INFERENCE_STOPPED;
 static bool continuous_mode = false;
 static bool debug_mode = false;
 static bool is_fusion = false;
-static float samples_circ_buff[EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE];
-static int samples_wr_index = 0;
 static EiDeviceNRF7002DK *dev = static_cast<EiDeviceNRF7002DK*>(EiDeviceInfo::get_device());
 
+static EiSamplesRing<SAMPLES_RING_SIZE> samples_ring;
+/* wakes up inference thread on start, stop and when window of samples is ready */
+K_SEM_DEFINE(inference_sem, 0, 1);
+/* given by the inference thread once it's stopped and the classifier state is released */
+K_SEM_DEFINE(inference_idle_sem, 0, 1);
+extern const k_tid_t inference_thread_id;
+/* set by start while the inference thread is idle, cleared by the inference thread on teardown */
+static volatile bool classifier_active = false;
+#ifdef CONFIG_EI_RESULT_EVENTS
+BUILD_ASSERT(CONFIG_EI_RESULT_EVENTS_MIN_SAME <= CONFIG_EI_RESULT_EVENTS_READINGS,
+    "EI_RESULT_EVENTS_MIN_SAME can't be more than EI_RESULT_EVENTS_READINGS");
+/* set up by start, released by the inference thread on teardown */
+static ei_classifier_event_t result_events;
+#endif
+
 static inline inference_state_t set_thread_state(inference_state_t new_state)
 {
     if(state != INFERENCE_STOPPED) {
@@ -69,35 +90,64 @@ static inline inference_state_t set_thread_state(inference_state_t new_state)
     return state;
 }
 
+/**
+ * @brief Get data from the ring without copying it to a linear buffer first,
+ * offset is relative to the oldest sample not consumed yet
+ */
+static int samples_ring_get_data(size_t offset, size_t length, float *out_ptr)
+{
+    samples_ring.read(offset, length, out_ptr);
+
+    return 0;
+}
+
 /**
  * @brief Called for each single sample
  *
  */
 bool samples_callback(const void *raw_sample, uint32_t raw_sample_size)
 {
+    EI_TRACE_ZONE("samples_callback");
+
     if(state != INFERENCE_SAMPLING) {
         // stop collecting samples if we are not in SAMPLING state
         return true;
     }
 
-    float *sample = (float *)raw_sample;
+    const float *sample = (const float *)raw_sample;
+    size_t n_values = raw_sample_size / sizeof(float);
 
-    for(int i = 0; i < (int)(raw_sample_size / sizeof(float)); i++) {
-        samples_circ_buff[samples_wr_index++] = sample[i];
-        if(samples_wr_index > EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE) {
-            /* start from beginning of the circular buffer */
-            samples_wr_index = 0;
-        }
-        if(samples_wr_index >= samples_per_inference) {
-            // we don't care about current state, it will be handled in the thread or next call of samples_callback
-            set_thread_state(INFERENCE_DATA_READY);
-            return true;
-        }
+    // inference thread is behind, the whole sample is dropped instead of overwriting the window
+    size_t count = samples_ring.push(sample, n_values);
+    if (count == 0) {
+        return false;
+    }
+
+    if (count >= samples_per_inference) {
+        k_sem_give(&inference_sem);
+        // in continuous mode keep sampling while the window is processed
+        return !continuous_mode;
     }
 
     return false;
 }
 
+static void start_sampling(void)
+{
+#if MULTI_FREQ_ENABLED == 1
+    if (is_fusion) {
+        ei_multi_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
+    }
+    else {
+        ei_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
+    }
+#else
+    ei_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
+#endif
+    dev->set_state(eiStateSampling);
+}
+
+#ifndef CONFIG_EI_RESULT_EVENTS
 static void process_results(ei_impulse_result_t* result)
 {
     char *string = NULL;
@@ -136,59 +186,100 @@ static void process_results(ei_impulse_result_t* result)
         k_free(string);
     }
 }
+#else
+/**
+ * @brief Report the result only when the smoothed label changes
+ */
+static void process_result_events(ei_impulse_result_t* result)
+{
+    if (!ei_classifier_event_update(&result_events, result)) {
+        return;
+    }
+
+    const char *label = ei_classifier_event_label(&result_events, result);
+    float value = result_events.state >= 0 ? result->classification[result_events.state].value : 0.0f;
+    float anomaly = 0.0f;
+#if EI_CLASSIFIER_HAS_ANOMALY == 1
+    anomaly = result->anomaly;
+#endif
+
+    if(dev->get_serial_channel() == UART) {
+        ei_printf("Event: %s (%.5f, anomaly %.3f)\n", label, value, anomaly);
+    }
+    else {
+        uint8_t msg[256];
+        int msg_len = get_inference_event_msg(msg, sizeof(msg), label, value, anomaly);
+        if (msg_len == 0 || !ei_ws_send_binary(msg, msg_len, EVENT_SEND_TIMEOUT_MS)) {
+            LOG_WRN("Failed to send inference event");
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Release the classifier state (FFT plans, arena, EON model), called only from the
+ * inference thread, which is the one using it
+ */
+static void inference_teardown(void)
+{
+    run_classifier_deinit();
+#ifdef CONFIG_EI_RESULT_EVENTS
+    ei_classifier_event_free(&result_events);
+    result_events.smooth.last_readings = NULL;
+#endif
+    classifier_active = false;
+}
 
 void ei_inference_thread(void* param1, void* param2, void* param3)
 {
     while(1) {
         switch(state) {
             case INFERENCE_STOPPED:
+                if (classifier_active) {
+                    inference_teardown();
+                }
+                k_sem_give(&inference_idle_sem);
                 // nothing to do
-                ei_sleep(5);
+                k_sem_take(&inference_sem, K_FOREVER);
                 continue;
-            case INFERENCE_WAITING:
-                ei_sleep(2000);
+            case INFERENCE_WAITING: {
+                // stop wakes the thread up before the delay is over
+                int64_t sampling_start = k_uptime_get() + 2000;
+                while (state == INFERENCE_WAITING) {
+                    int64_t remaining = sampling_start - k_uptime_get();
+                    if (remaining <= 0) {
+                        break;
+                    }
+                    k_sem_take(&inference_sem, K_MSEC(remaining));
+                }
                 if(set_thread_state(INFERENCE_SAMPLING) == INFERENCE_STOPPED) {
                     // if someone stopped inference during delay, go to thread loop iteration
                     continue;
                 }
                 // start sampling now, don't collect samples during waiting period
-#if MULTI_FREQ_ENABLED == 1
-                if (is_fusion) {
-                    ei_multi_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
-                }
-                else {
-                    ei_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
-                }
-#else
-                ei_fusion_sample_start(&samples_callback, EI_CLASSIFIER_INTERVAL_MS);
-#endif
-                dev->set_state(eiStateSampling);
+                samples_ring.reset();
+                start_sampling();
                 continue;
+            }
             case INFERENCE_SAMPLING:
                 // wait for data to be collected through callback
-                ei_sleep(1);
-                continue;
-            case INFERENCE_DATA_READY:
-                dev->set_state(eiStateIdle);
+                if(samples_ring.available() < samples_per_inference) {
+                    k_sem_take(&inference_sem, K_FOREVER);
+                    continue;
+                }
+                if(continuous_mode == false) {
+                    dev->set_state(eiStateIdle);
+                }
                 // nothing to do, just continue to inference provcessing below
                 break;
             default:
                 break;
         }
 
+        // Create a data structure to represent this window of data, read in place from the ring
         signal_t signal;
-
-        // shift circular buffer, so the newest data will be the first
-        // if samples_wr_index is 0, then roll is immediately returning
-        numpy::roll(samples_circ_buff, EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE, (-samples_wr_index));
-        /* reset wr index, the oldest data will be overwritten */
-        samples_wr_index = 0;
-
-        // Create a data structure to represent this window of data
-        int err = numpy::signal_from_buffer(samples_circ_buff, EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE, &signal);
-        if (err != 0) {
-            ei_printf("ERR: signal_from_buffer failed (%d)\n", err);
-        }
+        signal.total_length = samples_per_inference;
+        signal.get_data = &samples_ring_get_data;
 
         // run the impulse: DSP, neural network and the Anomaly algorithm
         ei_impulse_result_t result = { 0 };
@@ -200,12 +291,24 @@ void ei_inference_thread(void* param1, void* param2, void* param3)
             ei_error = run_classifier(&signal, &result, debug_mode);
         }
 
+        samples_ring.consume(samples_per_inference);
+
         if (ei_error != EI_IMPULSE_OK) {
             ei_printf("Failed to run impulse (%d)", ei_error);
-            set_thread_state(INFERENCE_STOPPED);
+            ei_stop_impulse();
             continue;
         }
 
+#ifdef CONFIG_EI_RESULT_EVENTS
+        // the results are smoothed by the event detector, so feed it every result
+        // as soon as the continuous model window is filled
+        if(continuous_mode == true && print_results < 0) {
+            print_results++;
+        }
+        else {
+            process_result_events(&result);
+        }
+#else
         if(continuous_mode == true) {
             if(++print_results >= (EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW >> 1)) {
                 process_results(&result);
@@ -215,11 +318,9 @@ void ei_inference_thread(void* param1, void* param2, void* param3)
         else {
             process_results(&result);
         }
+#endif
 
-        if(continuous_mode == true) {
-            set_thread_state(INFERENCE_SAMPLING);
-        }
-        else {
+        if(continuous_mode == false) {
             ei_printf("Starting inferencing in 2 seconds...\n");
             set_thread_state(INFERENCE_WAITING);
         }
@@ -229,6 +330,10 @@ void ei_inference_thread(void* param1, void* param2, void* param3)
 void ei_start_impulse(bool continuous, bool debug, bool use_max_uart_speed)
 {
     const char *axis_name = EI_CLASSIFIER_FUSION_AXES_STRING;
+
+    // the inference thread has to be idle before the classifier is set up again
+    ei_stop_impulse();
+
     if (!ei_connect_fusion_list(axis_name, AXIS_FORMAT)) {
         ei_printf("ERR: Failed to find sensor '%s' in the sensor list\n", axis_name);
         return;
@@ -249,8 +354,19 @@ void ei_start_impulse(bool continuous, bool debug, bool use_max_uart_speed)
                                             sizeof(ei_classifier_inferencing_categories[0]));
     ei_printf("Starting inferencing, press 'b' to break\n");
 
+#ifdef CONFIG_EI_RESULT_EVENTS
+    // the inference thread is idle, it frees the events again on teardown
+    ei_classifier_event_init(&result_events, CONFIG_EI_RESULT_EVENTS_READINGS,
+        CONFIG_EI_RESULT_EVENTS_MIN_SAME, CONFIG_EI_RESULT_EVENTS_DEBOUNCE,
+        CONFIG_EI_RESULT_EVENTS_ENTER_CONFIDENCE / 100.0f,
+        CONFIG_EI_RESULT_EVENTS_EXIT_CONFIDENCE / 100.0f,
+        CONFIG_EI_RESULT_EVENTS_ANOMALY / 100.0f);
+    ei_printf("Only changes of the result are reported\n");
+#endif
+
     dev->set_sample_length_ms(EI_CLASSIFIER_RAW_SAMPLE_COUNT * EI_CLASSIFIER_INTERVAL_MS);
     dev->set_sample_interval_ms(EI_CLASSIFIER_INTERVAL_MS);
+    classifier_active = true;
 
     if (continuous == true) {
         samples_per_inference = EI_CLASSIFIER_SLICE_SIZE * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME;
@@ -260,7 +376,9 @@ void ei_start_impulse(bool continuous, bool debug, bool use_max_uart_speed)
         // only print when we run the complete maf buffer to prevent printing the same classification multiple times.
         print_results = -(EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW);
         run_classifier_init();
+        samples_ring.reset();
         state = INFERENCE_SAMPLING;
+        start_sampling();
     }
     else {
         samples_per_inference = EI_CLASSIFIER_RAW_SAMPLE_COUNT * EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME;
@@ -268,17 +386,28 @@ void ei_start_impulse(bool continuous, bool debug, bool use_max_uart_speed)
         ei_printf("Starting inferencing in 2 seconds...\n");
         state = INFERENCE_WAITING;
     }
+    k_sem_give(&inference_sem);
 }
 
+/**
+ * @brief Stop inference, the classifier state is released by the inference thread when it
+ * finishes the current window. Called from another thread, this waits until it's done.
+ */
 void ei_stop_impulse(void)
 {
     if(state != INFERENCE_STOPPED) {
+        k_sem_reset(&inference_idle_sem);
         set_thread_state(INFERENCE_STOPPED);
+        dev->stop_sample_thread();
+        k_sem_give(&inference_sem);
         ei_printf("Inferencing stopped by user\r\n");
         dev->set_state(eiStateFinished);
-        /* reset samples buffer */
-        samples_wr_index = 0;
-        run_classifier_deinit();
+        if (samples_ring.get_dropped() > 0) {
+            LOG_WRN("Inference too slow, %u samples dropped", samples_ring.get_dropped());
+        }
+        if (k_current_get() != inference_thread_id) {
+            k_sem_take(&inference_idle_sem, K_FOREVER);
+        }
     }
 }
 
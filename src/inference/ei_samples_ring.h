@@ -0,0 +1,135 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_SAMPLES_RING_H
+#define EI_SAMPLES_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Single producer (sampler callback), single consumer (inference thread) ring of
+ * sample values. wr_index is used only by the producer, rd_index only by the consumer,
+ * the shared count publishes a sample only when it's complete.
+ */
+template<size_t N>
+class EiSamplesRing {
+public:
+    EiSamplesRing() : wr_index(0), rd_index(0), count(0), dropped(0) { }
+
+    /**
+     * @brief Reset the ring, it can be called only if sampling is not running
+     */
+    void reset(void)
+    {
+        wr_index = 0;
+        rd_index = 0;
+        count.store(0);
+        dropped.store(0);
+    }
+
+    /**
+     * @brief Producer: add a sample of n_values, the whole sample is dropped if it
+     * doesn't fit instead of overwriting the window being processed
+     * @return number of values in the ring, 0 if the sample was dropped or empty
+     */
+    size_t push(const float *values, size_t n_values)
+    {
+        size_t used = count.load(std::memory_order_acquire);
+
+        if (n_values == 0) {
+            return 0;
+        }
+        if (used + n_values > N) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+
+        size_t first = n_values < N - wr_index ? n_values : N - wr_index;
+        memcpy(&ring[wr_index], values, first * sizeof(float));
+        memcpy(&ring[0], values + first, (n_values - first) * sizeof(float));
+        wr_index = (wr_index + n_values) % N;
+
+        return count.fetch_add(n_values, std::memory_order_release) + n_values;
+    }
+
+    /**
+     * @brief Consumer: number of values ready to be read
+     */
+    size_t available(void) const
+    {
+        return count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Consumer: copy values without consuming them, offset is relative to the
+     * oldest value not consumed yet
+     */
+    void read(size_t offset, size_t length, float *out_ptr) const
+    {
+        size_t start = (rd_index + offset) % N;
+        size_t first = length < N - start ? length : N - start;
+
+        memcpy(out_ptr, &ring[start], first * sizeof(float));
+        memcpy(out_ptr + first, &ring[0], (length - first) * sizeof(float));
+    }
+
+    /**
+     * @brief Consumer: release values after they were processed
+     */
+    void consume(size_t length)
+    {
+        rd_index = (rd_index + length) % N;
+        count.fetch_sub(length, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of samples dropped since the last reset
+     */
+    uint32_t get_dropped(void) const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    float ring[N];
+    size_t wr_index;
+    size_t rd_index;
+    std::atomic<size_t> count;
+    std::atomic<uint32_t> dropped;
+};
+
+#endif /* EI_SAMPLES_RING_H */
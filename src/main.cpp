@@ -35,6 +35,7 @@
 #include "ei_at_handlers.h"
 #include "ei_device_nordic_nrf7002dk.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include "inference/ei_run_impulse.h"
 #include "sensors/ei_inertial_sensor.h"
 #include "wifi/wifi.h"
@@ -60,6 +61,11 @@ int main(void)
     // /* Switch CPU core clock to 128 MHz */
     nrfx_clock_divider_set(NRF_CLOCK_DOMAIN_HFCLK, NRF_CLOCK_HFCLK_DIV_1);
 
+#ifdef CONFIG_EI_TRACE
+    /* Start the cycle counter used for trace zones */
+    ei_trace_init();
+#endif
+
     /* Initialize board uart */
     if(uart_init() != 0) {
         LOG_ERR("Init uart on board error occured\r\n");
@@ -36,6 +36,12 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
+#ifdef CONFIG_EI_ACC_FIFO
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/sys/byteorder.h>
+#include <cmath>
+#endif
 #include "ei_inertial_sensor.h"
 #include "ei_device_nordic_nrf7002dk.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
@@ -46,9 +52,60 @@ LOG_MODULE_REGISTER(acc_sensor);
 
 /* Constant defines -------------------------------------------------------- */
 #define CONVERT_G_TO_MS2    9.80665f
+#define ACC_FULL_SCALE_G    2
 
 const struct device *iis2dlpc;
 
+#ifdef CONFIG_EI_ACC_FIFO
+#define IIS2DLPC_NODE                   DT_COMPAT_GET_ANY_STATUS_OKAY(st_iis2dlpc)
+
+/* IIS2DLPC registers and bits */
+#define IIS2DLPC_OUT_X_L                0x28
+#define IIS2DLPC_CTRL4_INT1_PAD_CTRL    0x23
+#define IIS2DLPC_CTRL5_INT2_PAD_CTRL    0x24
+#define IIS2DLPC_INT_FTH                BIT(1)
+#define IIS2DLPC_FIFO_CTRL              0x2E
+#define IIS2DLPC_FIFO_MODE_BYPASS       (0x0 << 5)
+#define IIS2DLPC_FIFO_MODE_CONTINUOUS   (0x6 << 5)
+#define IIS2DLPC_FIFO_SAMPLES           0x2F
+#define IIS2DLPC_FIFO_OVR               BIT(6)
+#define IIS2DLPC_FIFO_DIFF_MASK         0x3F
+#define IIS2DLPC_FIFO_DEPTH             32
+#define IIS2DLPC_DEFAULT_ODR            1600
+/* retry delay after a failed FIFO read, the interrupt is re-armed afterwards */
+#define FIFO_RETRY_MS                   5
+
+/* output is left aligned 16 bit */
+#define FIFO_RAW_TO_MS2     ((float)ACC_FULL_SCALE_G / 32768.0f * CONVERT_G_TO_MS2)
+
+BUILD_ASSERT(CONFIG_EI_ACC_FIFO_WATERMARK < IIS2DLPC_FIFO_DEPTH, "FIFO watermark must be lower than FIFO depth");
+BUILD_ASSERT(DT_NODE_HAS_PROP(IIS2DLPC_NODE, drdy_gpios), "FIFO mode requires IIS2DLPC interrupt pin (drdy-gpios)");
+
+static const struct i2c_dt_spec iis2dlpc_i2c = I2C_DT_SPEC_GET(IIS2DLPC_NODE);
+static const struct gpio_dt_spec iis2dlpc_int = GPIO_DT_SPEC_GET(IIS2DLPC_NODE, drdy_gpios);
+static const float fifo_odr[] = { 12.5f, 25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f };
+
+static struct gpio_callback fifo_int_cb;
+static void fifo_work_handler(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(fifo_work, fifo_work_handler);
+
+/* interrupt is level based, it's disabled here and re-armed when the FIFO is drained */
+static void fifo_int_handler(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    gpio_pin_interrupt_configure_dt(&iis2dlpc_int, GPIO_INT_DISABLE);
+    k_work_reschedule(&fifo_work, K_NO_WAIT);
+}
+
+static void (*fifo_sample_cb)(void);
+static volatile bool fifo_running = false;
+static float fifo_block[IIS2DLPC_FIFO_DEPTH][ACCEL_AXIS_SAMPLED];
+static int fifo_block_ix;
+static uint32_t fifo_overruns;
+static struct k_work_sync fifo_work_sync;
+/* stop was called from the work queue, the work handler tears down the FIFO mode */
+static volatile bool fifo_teardown_pending = false;
+#endif
+
 static void iis2dlpc_config(const struct device *iis2dlpc)
 {
     struct sensor_value odr_attr, fs_attr;
@@ -63,7 +120,7 @@ static void iis2dlpc_config(const struct device *iis2dlpc)
         return;
     }
 
-    sensor_g_to_ms2(2, &fs_attr);
+    sensor_g_to_ms2(ACC_FULL_SCALE_G, &fs_attr);
 
     if (sensor_attr_set(iis2dlpc, SENSOR_CHAN_ACCEL_XYZ,
                 SENSOR_ATTR_FULL_SCALE, &fs_attr) < 0) {
@@ -88,6 +145,15 @@ bool ei_inertial_init(void)
 
     iis2dlpc_config(iis2dlpc);
 
+#ifdef CONFIG_EI_ACC_FIFO
+    if (!gpio_is_ready_dt(&iis2dlpc_int) || gpio_pin_configure_dt(&iis2dlpc_int, GPIO_INPUT) < 0) {
+        LOG_ERR("IIS2DLPC interrupt pin not available");
+        return false;
+    }
+    gpio_init_callback(&fifo_int_cb, fifo_int_handler, BIT(iis2dlpc_int.pin));
+    gpio_add_callback(iis2dlpc_int.port, &fifo_int_cb);
+#endif
+
     if(ei_add_sensor_to_fusion_list(accelerometer_sensor) == false) {
         LOG_ERR("ERR: failed to register accelerometer sensor!");
         return false;
@@ -106,6 +172,13 @@ float *ei_fusion_acc_read_data(int n_samples)
     struct sensor_value accel2[ACCEL_AXIS_SAMPLED];
     static float acceleration_g[ACCEL_AXIS_SAMPLED];
 
+#ifdef CONFIG_EI_ACC_FIFO
+    // sample already drained from FIFO
+    if (fifo_running) {
+        return fifo_block[fifo_block_ix];
+    }
+#endif
+
     memset(acceleration_g, 0, ACCEL_AXIS_SAMPLED * sizeof(float));
 
     if (sensor_sample_fetch(iis2dlpc) < 0) {
@@ -119,4 +192,168 @@ float *ei_fusion_acc_read_data(int n_samples)
     }
 
     return acceleration_g;
-}
\ No newline at end of file
+}
+#ifdef CONFIG_EI_ACC_FIFO
+/**
+ * @brief      Disable the FIFO and its interrupt and restore the default ODR, the work
+ *             handler must not be running
+ */
+static void fifo_teardown(void)
+{
+    struct sensor_value odr_attr;
+
+    gpio_pin_interrupt_configure_dt(&iis2dlpc_int, GPIO_INT_DISABLE);
+    i2c_reg_update_byte_dt(&iis2dlpc_i2c,
+                           DT_PROP_OR(IIS2DLPC_NODE, drdy_int, 1) == 2 ? IIS2DLPC_CTRL5_INT2_PAD_CTRL : IIS2DLPC_CTRL4_INT1_PAD_CTRL,
+                           IIS2DLPC_INT_FTH, 0);
+    i2c_reg_write_byte_dt(&iis2dlpc_i2c, IIS2DLPC_FIFO_CTRL, IIS2DLPC_FIFO_MODE_BYPASS);
+
+    odr_attr.val1 = IIS2DLPC_DEFAULT_ODR;
+    odr_attr.val2 = 0;
+    sensor_attr_set(iis2dlpc, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &odr_attr);
+
+    if (fifo_overruns) {
+        LOG_WRN("IIS2DLPC FIFO overrun %u times", fifo_overruns);
+    }
+}
+
+/**
+ * @brief      Read all samples from the FIFO and pass them one by one to the sampler
+ *             callback, they are returned by ei_fusion_acc_read_data
+ */
+static void fifo_work_handler(struct k_work *work)
+{
+    uint8_t fifo_samples;
+    int16_t raw[IIS2DLPC_FIFO_DEPTH][ACCEL_AXIS_SAMPLED];
+    int n_samples;
+
+    // drain until FIFO is below the watermark, then re-arm the level interrupt
+    while (fifo_running) {
+        if (i2c_reg_read_byte_dt(&iis2dlpc_i2c, IIS2DLPC_FIFO_SAMPLES, &fifo_samples) < 0) {
+            // INT line stays active, try again later instead of waiting for the interrupt
+            LOG_ERR("IIS2DLPC FIFO status read error");
+            k_work_reschedule(&fifo_work, K_MSEC(FIFO_RETRY_MS));
+            return;
+        }
+
+        if (fifo_samples & IIS2DLPC_FIFO_OVR) {
+            fifo_overruns++;
+        }
+
+        n_samples = fifo_samples & IIS2DLPC_FIFO_DIFF_MASK;
+        if (n_samples < CONFIG_EI_ACC_FIFO_WATERMARK) {
+            break;
+        }
+        n_samples = MIN(n_samples, IIS2DLPC_FIFO_DEPTH);
+
+        // in FIFO mode the address rolls back to OUT_X_L, so whole FIFO is read in one burst
+        if (i2c_burst_read_dt(&iis2dlpc_i2c, IIS2DLPC_OUT_X_L, (uint8_t *)raw,
+                              n_samples * ACCEL_AXIS_SAMPLED * sizeof(int16_t)) < 0) {
+            LOG_ERR("IIS2DLPC FIFO read error");
+            k_work_reschedule(&fifo_work, K_MSEC(FIFO_RETRY_MS));
+            return;
+        }
+
+        for (int i = 0; i < n_samples; i++) {
+            for (int j = 0; j < ACCEL_AXIS_SAMPLED; j++) {
+                fifo_block[i][j] = (int16_t)sys_le16_to_cpu(raw[i][j]) * FIFO_RAW_TO_MS2;
+            }
+        }
+
+        // samples are ODR spaced, sampler may stop in the middle of the block
+        for (fifo_block_ix = 0; fifo_block_ix < n_samples && fifo_running; fifo_block_ix++) {
+            fifo_sample_cb();
+        }
+    }
+
+    if (fifo_running) {
+        gpio_pin_interrupt_configure_dt(&iis2dlpc_int, GPIO_INT_LEVEL_ACTIVE);
+    }
+    else if (fifo_teardown_pending) {
+        fifo_teardown_pending = false;
+        fifo_teardown();
+    }
+}
+
+/**
+ * @brief      Start FIFO based sampling, sensor ODR is set to the sampling
+ *             frequency and the FIFO is drained on a watermark interrupt
+ *
+ * @param      sample_cb           Called for every sample read from the FIFO
+ * @param      sample_interval_ms  Sampling interval, has to match one of the sensor ODRs
+ *
+ * @return     false if FIFO can't be used for this sampling interval (e.g. 62.5 Hz, which
+ *             isn't an integer fraction of any ODR), the caller samples on a timer then
+ */
+bool ei_inertial_fifo_start(void (*sample_cb)(void), float sample_interval_ms)
+{
+    struct sensor_value odr_attr;
+    float frequency = 1000.0f / sample_interval_ms;
+    int odr_ix;
+
+    // a stop from the sample callback leaves the teardown to the work handler, finish it first
+    if (fifo_teardown_pending) {
+        k_work_cancel_delayable_sync(&fifo_work, &fifo_work_sync);
+        if (fifo_teardown_pending) {
+            fifo_teardown_pending = false;
+            fifo_teardown();
+        }
+    }
+
+    for (odr_ix = 0; odr_ix < (int)ARRAY_SIZE(fifo_odr); odr_ix++) {
+        if (fabsf(fifo_odr[odr_ix] - frequency) < 0.01f) {
+            break;
+        }
+    }
+    if (odr_ix == ARRAY_SIZE(fifo_odr)) {
+        return false;
+    }
+
+    sensor_value_from_double(&odr_attr, fifo_odr[odr_ix]);
+    if (sensor_attr_set(iis2dlpc, SENSOR_CHAN_ACCEL_XYZ,
+                SENSOR_ATTR_SAMPLING_FREQUENCY, &odr_attr) < 0) {
+        LOG_ERR("Cannot set sampling frequency for IIS2DLPC accel");
+        return false;
+    }
+
+    fifo_sample_cb = sample_cb;
+    fifo_overruns = 0;
+    fifo_running = true;
+
+    // bypass mode flushes the FIFO
+    i2c_reg_write_byte_dt(&iis2dlpc_i2c, IIS2DLPC_FIFO_CTRL, IIS2DLPC_FIFO_MODE_BYPASS);
+    i2c_reg_write_byte_dt(&iis2dlpc_i2c, IIS2DLPC_FIFO_CTRL,
+                          IIS2DLPC_FIFO_MODE_CONTINUOUS | CONFIG_EI_ACC_FIFO_WATERMARK);
+    i2c_reg_update_byte_dt(&iis2dlpc_i2c,
+                           DT_PROP_OR(IIS2DLPC_NODE, drdy_int, 1) == 2 ? IIS2DLPC_CTRL5_INT2_PAD_CTRL : IIS2DLPC_CTRL4_INT1_PAD_CTRL,
+                           IIS2DLPC_INT_FTH, IIS2DLPC_INT_FTH);
+    gpio_pin_interrupt_configure_dt(&iis2dlpc_int, GPIO_INT_LEVEL_ACTIVE);
+
+    LOG_DBG("IIS2DLPC FIFO sampling at %d mHz", (int)(fifo_odr[odr_ix] * 1000));
+
+    return true;
+}
+
+/**
+ * @brief      Stop FIFO based sampling and restore the default ODR
+ */
+void ei_inertial_fifo_stop(void)
+{
+    if (!fifo_running) {
+        return;
+    }
+    fifo_running = false;
+
+    // the sampler stops from the sample callback, i.e. from within fifo_work_handler, waiting
+    // for the handler there would deadlock the work queue. The handler doesn't re-arm the
+    // interrupt once it sees fifo_running cleared and tears down when it's done.
+    if (k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
+        fifo_teardown_pending = true;
+        k_work_reschedule(&fifo_work, K_NO_WAIT);
+        return;
+    }
+
+    k_work_cancel_delayable_sync(&fifo_work, &fifo_work_sync);
+    fifo_teardown();
+}
+#endif
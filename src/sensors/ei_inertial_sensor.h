@@ -47,6 +47,10 @@
 /* Function prototypes ----------------------------------------------------- */
 bool ei_inertial_init(void);
 float *ei_fusion_acc_read_data(int n_samples);
+#ifdef CONFIG_EI_ACC_FIFO
+bool ei_inertial_fifo_start(void (*sample_cb)(void), float sample_interval_ms);
+void ei_inertial_fifo_stop(void);
+#endif
 
 static const ei_device_fusion_sensor_t accelerometer_sensor = {
     // name of sensor module to be displayed in fusion list
@@ -54,7 +58,12 @@ static const ei_device_fusion_sensor_t accelerometer_sensor = {
     // number of sensor module axis
     ACCEL_AXIS_SAMPLED,
     // sampling frequencies
+#ifdef CONFIG_EI_ACC_FIFO
+    // FIFO is used when frequency matches the sensor ODR, 20 and 62.5 Hz use the timer
+    { 20.0f, 62.5f, 100.0f, 200.0f, 400.0f },
+#else
     { 20.0f, 62.5f, 100.0f },
+#endif
     // axis name and units payload (must be same order as read in)
     { {"accX", "m/s2"}, {"accY", "m/s2"}, {"accZ", "m/s2"} },
     // reference to read data function
@@ -38,7 +38,9 @@ LOG_MODULE_REGISTER(ei_ws_client, CONFIG_REMOTE_INGESTION_LOG_LEVEL);
 #include "firmware-sdk/ei_device_info_lib.h"
 #include "firmware-sdk/ei_device_memory.h"
 #include "ei_ws_client.h"
+#include "ei_ws_stream.h"
 #include "firmware-sdk/remote-mgmt.h"
+#include "edge-impulse-sdk/dsp/ei_trace.h"
 #include "ei_device_nordic_nrf7002dk.h"
 #include <zephyr/kernel.h>
 #include <zephyr/net/net_ip.h>
@@ -55,15 +57,25 @@ using namespace std;
 
 typedef struct {
     uint32_t samples_addr;
+    uint16_t status_code;
+    bool complete;
 } http_priv_data_t;
 
+typedef struct {
+    uint32_t address;
+    size_t length;
+    uint8_t *buffer;
+} upload_read_t;
+
 static int remote_mgmt_socket = -1;
 static int remote_mgmt_http_socket = -1;
 static int ingestion_socket = -1;
+static int64_t ingestion_last_used;
 static bool is_connected = false;
 static struct k_thread ws_read_thread_data;
 static EiDeviceInfo *device;
 static struct addrinfo *ingestion_addrinfo;
+static string stream_sensor;
 bool (*sample_start_handler)(const char **, const int);
 void ws_ping_work_handler(struct k_work *work);
 void ws_ping_timer_handler(struct k_timer *dummy);
@@ -71,6 +83,17 @@ void ws_ping_timer_handler(struct k_timer *dummy);
 K_THREAD_STACK_DEFINE(ws_read_stack, 8192);
 K_WORK_DEFINE(ws_ping_work, ws_ping_work_handler);
 K_TIMER_DEFINE(ws_ping_timer, ws_ping_timer_handler, NULL);
+/* messages are sent from remote management, ping and streaming threads */
+K_MUTEX_DEFINE(ws_tx_mutex);
+
+/* Upload pipeline, next chunk is read by upload_read_work_q while the current one is sent */
+static void upload_read_work_handler(struct k_work *work);
+static uint8_t upload_buf[2][CONFIG_EI_INGESTION_CHUNK_SIZE] __aligned(4);
+static upload_read_t upload_read;
+static struct k_work_q upload_read_work_q;
+K_THREAD_STACK_DEFINE(upload_read_stack, CONFIG_EI_INGESTION_READ_THREAD_STACK);
+K_WORK_DEFINE(upload_read_work, upload_read_work_handler);
+K_SEM_DEFINE(upload_read_sem, 0, 1);
 
 bool ws_sample_start(const char **argv, int n)
 {
@@ -121,7 +144,9 @@ void ws_ping_work_handler(struct k_work *work)
     }
 
     LOG_DBG("Ping!");
+    k_mutex_lock(&ws_tx_mutex, K_FOREVER);
     ret = websocket_send_msg(remote_mgmt_socket, NULL, 0, WEBSOCKET_OPCODE_PING, true, true, 100);
+    k_mutex_unlock(&ws_tx_mutex);
     if (ret < 0) {
         LOG_ERR("Failed to send ping! (%d)", ret);
     }
@@ -161,6 +186,11 @@ static bool server_connect(void)
     if(ingestion_addrinfo != NULL) {
         free(ingestion_addrinfo);
     }
+    // ingestion host may be different now
+    if(ingestion_socket >= 0) {
+        zsock_close(ingestion_socket);
+        ingestion_socket = -1;
+    }
 
     domain_name = get_domain_from_url(device->get_management_url());
     LOG_DBG("Resolving address: %s", domain_name.c_str());
@@ -241,17 +271,22 @@ static void parse_received_msg(const uint8_t *buf, size_t buf_len)
         auto msg = static_cast<SampleRequest*>(decoded_message.get());
         LOG_DBG("Sample request: %s", msg->sensor.c_str());
         const char* sensor = msg->sensor.c_str();
+        // sampler is shared with streaming, sample request takes over
+        ei_ws_stream_stop();
+        stream_sensor = msg->sensor;
         if(sample_start_handler) {
             sample_start_handler(&sensor, 1);
         }
     } else if (decoded_message->getType() == MessageType::StreamingStartRequestType) {
-        // auto msg = static_cast<StreamingStartRequest*>(decoded_message.get());
         LOG_DBG("Streaming Start request");
-        // not supported yet
+        // stream the last sampled sensor, or the first one available
+        if (stream_sensor.empty() && !ei_get_sensor_fusion_list().empty()) {
+            stream_sensor = ei_get_sensor_fusion_list().front().name;
+        }
+        ei_ws_stream_start(stream_sensor.c_str(), device->get_sample_interval_ms());
     } else if (decoded_message->getType() == MessageType::StreamingStopRequestType) {
-        // auto msg = static_cast<StreamingStopRequest*>(decoded_message.get());
         LOG_DBG("Streaming Stop request");
-        // not supported yet
+        ei_ws_stream_stop();
     }
     else {
         LOG_WRN("Unknown message type!");
@@ -311,7 +346,9 @@ void ws_read_handler(void *arg1, void *arg2, void *arg3)
 
         if(message_type & WEBSOCKET_FLAG_PING) {
             LOG_DBG("PING received, sending PONG");
+            k_mutex_lock(&ws_tx_mutex, K_FOREVER);
             websocket_send_msg(remote_mgmt_socket, buf, total_read, WEBSOCKET_OPCODE_PONG, true, true, SYS_FOREVER_MS);
+            k_mutex_unlock(&ws_tx_mutex);
             continue;
         }
         else if((message_type & WEBSOCKET_FLAG_BINARY) && (message_type & WEBSOCKET_FLAG_FINAL)) {
@@ -368,8 +405,13 @@ bool ei_ws_send_msg(TxMsgType msg_type, const char* data)
         break;
     }
 
-    ret = websocket_send_msg(remote_mgmt_socket, (const uint8_t*)tx_msg_buf, act_msg_len, WEBSOCKET_OPCODE_DATA_BINARY,
-                          true, true, SYS_FOREVER_MS);
+    k_mutex_lock(&ws_tx_mutex, K_FOREVER);
+    {
+        EI_TRACE_ZONE("ws_send");
+        ret = websocket_send_msg(remote_mgmt_socket, (const uint8_t*)tx_msg_buf, act_msg_len, WEBSOCKET_OPCODE_DATA_BINARY,
+                              true, true, SYS_FOREVER_MS);
+    }
+    k_mutex_unlock(&ws_tx_mutex);
     if(ret < 0) {
         LOG_ERR("Failed to send %s message! (%d)", msg_name.c_str(), ret);
         return false;
@@ -381,6 +423,31 @@ bool ei_ws_send_msg(TxMsgType msg_type, const char* data)
     return true;
 }
 
+bool ei_ws_send_binary(const uint8_t *buf, size_t len, int32_t timeout_ms)
+{
+    int ret;
+
+    if (!is_connected) {
+        return false;
+    }
+
+    if (k_mutex_lock(&ws_tx_mutex, K_MSEC(timeout_ms)) != 0) {
+        return false;
+    }
+    {
+        EI_TRACE_ZONE("ws_send");
+        ret = websocket_send_msg(remote_mgmt_socket, buf, len, WEBSOCKET_OPCODE_DATA_BINARY,
+                                 true, true, timeout_ms);
+    }
+    k_mutex_unlock(&ws_tx_mutex);
+    if (ret < 0) {
+        LOG_DBG("Failed to send binary message! (%d)", ret);
+        return false;
+    }
+
+    return true;
+}
+
 void ei_ws_client_start(EiDeviceInfo *dev, bool (*handler)(const char **, const int))
 {
     device = dev;
@@ -398,6 +465,7 @@ void ei_ws_client_start(EiDeviceInfo *dev, bool (*handler)(const char **, const
 
 void ei_ws_client_stop(void)
 {
+    ei_ws_stream_stop();
     k_timer_stop(&ws_ping_timer);
     k_thread_abort(&ws_read_thread_data);
     zsock_close(remote_mgmt_socket);
@@ -411,53 +479,114 @@ bool ei_ws_get_connection_status(void)
 
 static void response_cb(struct http_response *rsp, enum http_final_call final_data, void *user_data)
 {
-    int ret;
+    http_priv_data_t *priv_data = (http_priv_data_t *)user_data;
+
     if (final_data == HTTP_DATA_MORE) {
         LOG_DBG("Partial data received (%zd bytes)", rsp->data_len);
     } else if (final_data == HTTP_DATA_FINAL) {
         LOG_DBG("All the data received (%zd bytes)", rsp->data_len);
-        ret = zsock_close(ingestion_socket);
-        if(ret < 0) {
-            LOG_ERR("Failed to close ingestion socket! (%d)", errno);
-        }
+        // keep the connection open for the next sample
+        priv_data->status_code = rsp->http_status_code;
+        priv_data->complete = true;
     }
 
     LOG_HEXDUMP_DBG(rsp->recv_buf, rsp->recv_buf_len, "rx http buf");
     LOG_DBG("Response status %s", rsp->http_status);
 }
 
+static void upload_read_work_handler(struct k_work *work)
+{
+    EiDeviceMemory *memory = device->get_memory();
+
+    memory->read_sample_data(upload_read.buffer, upload_read.address, upload_read.length);
+    k_sem_give(&upload_read_sem);
+}
+
+/**
+ * @brief      Send the whole buffer, zsock_send may accept only part of it
+ * @return     0 on success, negative errno otherwise
+ */
+static int send_all(int sock, const uint8_t *buf, size_t len)
+{
+    EI_TRACE_ZONE("ingestion_send");
+
+    while (len > 0) {
+        ssize_t ret = zsock_send(sock, buf, len, 0);
+        if (ret < 0) {
+            return -errno;
+        }
+        buf += ret;
+        len -= ret;
+    }
+
+    return 0;
+}
+
 int ingestion_payload_cb(int sock, struct http_request *req, void *user_data)
 {
     EiDeviceMemory *memory = device->get_memory();
-    uint8_t buf[256];
     http_priv_data_t *priv_data = (http_priv_data_t *)user_data;
     size_t bytes_sent = 0;
+    size_t len;
+    int buf_ix = 0;
+    int ret = 0;
     LOG_DBG("Bytes to send: %d", req->payload_len);
 
+    len = MIN(sizeof(upload_buf[0]), req->payload_len);
+    memory->read_sample_data(upload_buf[buf_ix], priv_data->samples_addr, len);
+
     while(bytes_sent < req->payload_len) {
-        size_t len = MIN(sizeof(buf), req->payload_len - bytes_sent);
-        memory->read_sample_data(buf, priv_data->samples_addr + bytes_sent, len);
+        size_t next_pos = bytes_sent + len;
+        size_t next_len = MIN(sizeof(upload_buf[0]), req->payload_len - next_pos);
+
+        // start reading the next chunk before sending the current one
+        if (next_len > 0) {
+            upload_read.address = priv_data->samples_addr + next_pos;
+            upload_read.length = next_len;
+            upload_read.buffer = upload_buf[buf_ix ^ 1];
+            k_work_submit_to_queue(&upload_read_work_q, &upload_read_work);
+        }
 
         LOG_DBG("Sending %d bytes from %d (%d)", len, priv_data->samples_addr + bytes_sent, bytes_sent);
-        (void)send(sock, buf, len, 0);
-        bytes_sent += len;
+        ret = send_all(sock, upload_buf[buf_ix], len);
+
+        if (next_len > 0) {
+            k_sem_take(&upload_read_sem, K_FOREVER);
+        }
+
+        if (ret < 0) {
+            LOG_ERR("Failed to send sample data! (%d)", ret);
+            return ret;
+        }
+
+        bytes_sent = next_pos;
+        len = next_len;
+        buf_ix ^= 1;
     }
 
     return bytes_sent;
 }
 
-bool ei_ws_send_sample(size_t address, size_t length, bool cbor)
+/**
+ * @brief      Make sure there is a connection to the ingestion service,
+ *             reuse the existing one unless it was idle for too long
+ * @param[out] reused  True if an already open connection is used
+ * @return     True if connected
+ */
+static bool ingestion_connect(bool *reused)
 {
     int ret;
-    char api_key_header[128];
-    char label_header[128];
-    char content_type[128];
-    char label_x[128] = "";
-    static uint8_t temp_recv_buf_ipv4[512];
-    int32_t timeout = 3 * MSEC_PER_SEC;
-    string host;
-    struct http_request req;
-    http_priv_data_t priv_data;
+
+    *reused = false;
+    if (ingestion_socket >= 0) {
+        if (k_uptime_get() - ingestion_last_used < (CONFIG_EI_INGESTION_KEEPALIVE_TIMEOUT * MSEC_PER_SEC)) {
+            *reused = true;
+            return true;
+        }
+        LOG_DBG("Ingestion connection idle for too long, reconnecting");
+        zsock_close(ingestion_socket);
+        ingestion_socket = -1;
+    }
 
     LOG_DBG("Connecting to ingestion service...");
     ingestion_socket = zsock_socket(ingestion_addrinfo->ai_family, ingestion_addrinfo->ai_socktype, ingestion_addrinfo->ai_protocol);
@@ -468,10 +597,39 @@ bool ei_ws_send_sample(size_t address, size_t length, bool cbor)
     ret = zsock_connect(ingestion_socket, ingestion_addrinfo->ai_addr, ingestion_addrinfo->ai_addrlen);
     if (ret < 0) {
         LOG_ERR("Cannot create HTTP connection. ret = %d", ret);
+        zsock_close(ingestion_socket);
+        ingestion_socket = -1;
         return false;
     }
     LOG_DBG("Connecting to ingestion service... OK");
 
+    return true;
+}
+
+bool ei_ws_send_sample(size_t address, size_t length, bool cbor)
+{
+    int ret;
+    char api_key_header[128];
+    char label_header[128];
+    char content_type[128];
+    char label_x[128] = "";
+    static uint8_t temp_recv_buf_ipv4[512];
+    int32_t timeout = 3 * MSEC_PER_SEC;
+    string host;
+    struct http_request req;
+    http_priv_data_t priv_data;
+    bool reused;
+    int64_t start_time;
+    uint32_t upload_time;
+
+    static bool upload_read_work_q_started = false;
+    if (!upload_read_work_q_started) {
+        k_work_queue_start(&upload_read_work_q, upload_read_stack,
+                           K_THREAD_STACK_SIZEOF(upload_read_stack),
+                           CONFIG_EI_INGESTION_READ_THREAD_PRIO, NULL);
+        upload_read_work_q_started = true;
+    }
+
     snprintf(api_key_header, sizeof(api_key_header), "x-api-key: %s\r\n", device->get_upload_api_key().c_str());
     snprintf(label_header, sizeof(label_header), "x-file-name: %s\r\n", device->get_sample_label().c_str());
 
@@ -489,35 +647,64 @@ bool ei_ws_send_sample(size_t address, size_t length, bool cbor)
         // "x-disallow-duplicates\r\n",
         content_type,
         label_x,
+        "Connection: keep-alive\r\n",
         NULL
     };
 
     LOG_DBG("Samples len = %d", length);
     //LOG_HEXDUMP_DBG(buffer, length, "Sample");
 
-    memset(&req, 0, sizeof(req));
-
     host = get_domain_from_url(device->get_upload_host());
 
-    req.method = HTTP_POST;
-    req.url = device->get_upload_path().c_str();
-    req.host = host.c_str();
-    req.protocol = "HTTP/1.1";
-    req.optional_headers = extra_headers;
-    req.payload_cb = ingestion_payload_cb;
-    req.payload_len = length;
-    req.response = response_cb;
-    req.recv_buf = temp_recv_buf_ipv4;
-    req.recv_buf_len = sizeof(temp_recv_buf_ipv4);
-
-    priv_data.samples_addr = address;
-
-    ret = http_client_req(ingestion_socket, &req, timeout, &priv_data);
-    if(ret <0) {
-        LOG_ERR("Failed to send sample! (%d)", ret);
-        // k_free(buffer);
+    start_time = k_uptime_get();
+
+    // if the server closed a reused connection meanwhile, retry once on a new one
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!ingestion_connect(&reused)) {
+            return false;
+        }
+
+        memset(&req, 0, sizeof(req));
+        req.method = HTTP_POST;
+        req.url = device->get_upload_path().c_str();
+        req.host = host.c_str();
+        req.protocol = "HTTP/1.1";
+        req.optional_headers = extra_headers;
+        req.payload_cb = ingestion_payload_cb;
+        req.payload_len = length;
+        req.response = response_cb;
+        req.recv_buf = temp_recv_buf_ipv4;
+        req.recv_buf_len = sizeof(temp_recv_buf_ipv4);
+
+        memset(&priv_data, 0, sizeof(priv_data));
+        priv_data.samples_addr = address;
+
+        ret = http_client_req(ingestion_socket, &req, timeout, &priv_data);
+        if (ret >= 0 && priv_data.complete) {
+            break;
+        }
+
+        zsock_close(ingestion_socket);
+        ingestion_socket = -1;
+
+        if (!reused) {
+            LOG_ERR("Failed to send sample! (%d)", ret);
+            return false;
+        }
+        LOG_DBG("Ingestion connection closed by server, reconnecting");
+    }
+
+    ingestion_last_used = k_uptime_get();
+    upload_time = (uint32_t)(ingestion_last_used - start_time);
+
+    // KiB/s with two decimal places, 1000 ms/s * 100 / 1024 B/KiB
+    uint32_t rate = (uint32_t)(((uint64_t)length * 100000) / 1024 / MAX(upload_time, 1));
+    LOG_INF("Uploaded %u bytes in %u ms (%u.%02u KiB/s)", (uint32_t)length, upload_time, rate / 100, rate % 100);
+
+    if (priv_data.status_code < 200 || priv_data.status_code >= 300) {
+        LOG_ERR("Ingestion service responded with %u", priv_data.status_code);
         return false;
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -62,6 +62,15 @@ typedef enum {
 */
 bool ei_ws_send_msg(TxMsgType msg_type, const char* data = nullptr);
 
+/**
+ * @brief      Send an already encoded binary message to remote management service
+ * @param[in]  buf         Message buffer
+ * @param[in]  len         Message length
+ * @param[in]  timeout_ms  How long to wait for the link
+ * @return     True if message was sent successfully, false otherwise
+*/
+bool ei_ws_send_binary(const uint8_t *buf, size_t len, int32_t timeout_ms);
+
 /**
  * @brief      Start the websocket client thread
  * @param[in]  dev  Pointer to the device info object
@@ -0,0 +1,194 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ei_ws_stream, CONFIG_REMOTE_INGESTION_LOG_LEVEL);
+
+#include "firmware-sdk/ei_device_info_lib.h"
+#include "firmware-sdk/ei_fusion.h"
+#include "firmware-sdk/remote-mgmt.h"
+#include "ei_ws_client.h"
+#include "ei_ws_stream.h"
+#include "inference/ei_run_impulse.h"
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <cstring>
+
+#define STREAM_SEND_TIMEOUT_MS      500
+/* worst case CBOR size of a value is 9 bytes, plus map, labels and counters */
+#define STREAM_MSG_BUF_SIZE         (CONFIG_EI_WS_STREAM_FRAMES_PER_MSG * EI_MAX_SENSOR_AXES * 9 + 64)
+
+typedef struct {
+    uint16_t axes;
+    uint16_t frames;
+    float values[CONFIG_EI_WS_STREAM_FRAMES_PER_MSG * EI_MAX_SENSOR_AXES];
+} stream_batch_t;
+
+static void ei_ws_stream_thread(void* param1, void* param2, void* param3);
+
+K_MSGQ_DEFINE(stream_msgq, sizeof(stream_batch_t), CONFIG_EI_WS_STREAM_QUEUE_DEPTH, 4);
+K_THREAD_DEFINE(ei_ws_stream_thread_id, CONFIG_EI_WS_STREAM_THREAD_STACK, ei_ws_stream_thread, NULL, NULL, NULL, CONFIG_EI_WS_STREAM_THREAD_PRIO, 0, 0);
+
+static atomic_t stream_active = ATOMIC_INIT(0);
+static atomic_t frames_sent = ATOMIC_INIT(0);
+static atomic_t frames_dropped = ATOMIC_INIT(0);
+/* filled in sampler callback context */
+static stream_batch_t batch_in;
+/* used only by the streaming thread */
+static stream_batch_t batch_out;
+static uint8_t stream_msg_buf[STREAM_MSG_BUF_SIZE];
+
+/**
+ * @brief      Sampler callback, collects frames into batches and queues them for sending
+ * @return     True if sampling should be stopped
+ */
+static bool stream_samples_callback(const void *sample_buf, uint32_t byteLenght)
+{
+    uint32_t axes = byteLenght / sizeof(float);
+
+    if (atomic_get(&stream_active) == 0) {
+        return true;
+    }
+
+    // multi frequency sampling, no sensor sampled in this period
+    if (sample_buf == nullptr || axes == 0) {
+        return false;
+    }
+
+    axes = MIN(axes, EI_MAX_SENSOR_AXES);
+    memcpy(&batch_in.values[batch_in.frames * axes], sample_buf, axes * sizeof(float));
+    batch_in.axes = axes;
+    batch_in.frames++;
+
+    if (batch_in.frames >= CONFIG_EI_WS_STREAM_FRAMES_PER_MSG) {
+        if (k_msgq_put(&stream_msgq, &batch_in, K_NO_WAIT) != 0) {
+            // link is stalled, don't block the sampler
+            atomic_add(&frames_dropped, batch_in.frames);
+        }
+        batch_in.frames = 0;
+    }
+
+    return false;
+}
+
+static void ei_ws_stream_thread(void* param1, void* param2, void* param3)
+{
+    int msg_len;
+
+    while (1) {
+        k_msgq_get(&stream_msgq, &batch_out, K_FOREVER);
+
+        if (atomic_get(&stream_active) == 0) {
+            continue;
+        }
+
+        msg_len = get_sensor_frames_msg(stream_msg_buf, sizeof(stream_msg_buf),
+                                        batch_out.values, batch_out.axes, batch_out.frames,
+                                        atomic_get(&frames_dropped));
+        if (msg_len == 0 || !ei_ws_send_binary(stream_msg_buf, msg_len, STREAM_SEND_TIMEOUT_MS)) {
+            atomic_add(&frames_dropped, batch_out.frames);
+            continue;
+        }
+        atomic_add(&frames_sent, batch_out.frames);
+    }
+}
+
+bool ei_ws_stream_start(const char *sensor, float interval_ms)
+{
+    EiDeviceInfo *dev = EiDeviceInfo::get_device();
+    bool started;
+
+    if (atomic_get(&stream_active) != 0) {
+        ei_ws_stream_stop();
+    }
+
+    if (is_inference_running()) {
+        LOG_ERR("Streaming not possible while inference is running");
+        return false;
+    }
+
+    if (!ei_connect_fusion_list(sensor, SENSOR_FORMAT)) {
+        LOG_ERR("Failed to find sensor '%s' in the sensor list", sensor);
+        return false;
+    }
+
+    batch_in.frames = 0;
+    atomic_set(&frames_sent, 0);
+    atomic_set(&frames_dropped, 0);
+    k_msgq_purge(&stream_msgq);
+    atomic_set(&stream_active, 1);
+
+#if MULTI_FREQ_ENABLED == 1
+    if (ei_is_fusion()) {
+        started = ei_multi_fusion_sample_start(&stream_samples_callback, interval_ms);
+    }
+    else {
+        started = ei_fusion_sample_start(&stream_samples_callback, interval_ms);
+    }
+#else
+    started = ei_fusion_sample_start(&stream_samples_callback, interval_ms);
+#endif
+
+    if (!started) {
+        LOG_ERR("Failed to start streaming of '%s'", sensor);
+        atomic_set(&stream_active, 0);
+        return false;
+    }
+
+    LOG_INF("Streaming '%s' every %d ms", sensor, (int)interval_ms);
+    dev->set_state(eiStateSampling);
+
+    return true;
+}
+
+void ei_ws_stream_stop(void)
+{
+    EiDeviceInfo *dev = EiDeviceInfo::get_device();
+
+    if (atomic_cas(&stream_active, 1, 0) == false) {
+        return;
+    }
+
+    dev->stop_sample_thread();
+    k_msgq_purge(&stream_msgq);
+    dev->set_state(eiStateIdle);
+
+    LOG_INF("Streaming stopped, frames sent: %ld, dropped: %ld",
+            atomic_get(&frames_sent), atomic_get(&frames_dropped));
+}
+
+bool ei_ws_stream_is_active(void)
+{
+    return atomic_get(&stream_active) != 0;
+}